@@ -0,0 +1,94 @@
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "arena.h"
+
+//////////////////////////////////////////////////////////////////////
+// Round up to a whole number of chunks
+
+static size_t arena_round(size_t bytes) {
+	return (bytes + ARENA_CHUNK - 1) / ARENA_CHUNK * ARENA_CHUNK;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reserve address space for the given # of bytes without committing it
+
+arena_t arena_reserve(size_t bytes, int huge_pages) {
+
+	arena_t a;
+
+	a.reserved = arena_round(bytes ? bytes : 1);
+	a.committed = 0;
+	a.huge_pages = huge_pages;
+
+#ifdef _WIN32
+	// No reserve/commit split here: fall back to a lazy allocation
+	a.start = malloc(a.reserved);
+	if (a.start) { a.committed = a.reserved; }
+#else
+	a.start = mmap(NULL, a.reserved, PROT_NONE,
+		       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (a.start == MAP_FAILED) { a.start = NULL; }
+#endif
+
+	if (!a.start) {
+		fprintf(stderr, "unable to reserve %zu bytes of address space!\n",
+			a.reserved);
+		exit(1);
+	}
+
+	return a;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Make sure the first bytes of the arena are committed; return 0 if
+// that would exceed the reservation or the system refuses
+
+int arena_commit(arena_t* a, size_t bytes) {
+
+	if (bytes <= a->committed) { return 1; }
+	if (bytes > a->reserved) { return 0; }
+
+	size_t target = arena_round(bytes);
+	if (target > a->reserved) { target = a->reserved; }
+
+#ifndef _WIN32
+	uint8_t* begin = a->start + a->committed;
+	size_t len = target - a->committed;
+
+	if (mprotect(begin, len, PROT_READ | PROT_WRITE)) {
+		return 0;
+	}
+
+#ifdef MADV_HUGEPAGE
+	if (a->huge_pages) {
+		madvise(begin, len, MADV_HUGEPAGE);
+	}
+#endif
+#endif
+
+	a->committed = target;
+
+	return 1;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Return the whole reservation to the system
+
+void arena_release(arena_t* a) {
+
+#ifdef _WIN32
+	free(a->start);
+#else
+	if (a->start) {
+		munmap(a->start, a->reserved);
+	}
+#endif
+
+	a->start = NULL;
+	a->reserved = a->committed = 0;
+
+}
@@ -0,0 +1,37 @@
+#ifndef __ARENA__
+#define __ARENA__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Memory is committed in chunks of this size (one x86 huge page)
+#define ARENA_CHUNK ((size_t)2*1024*1024)
+
+// Contiguous range of address space reserved up front and backed by
+// memory only as it is used, so pointers into it stay valid while the
+// committed part grows up to the reserved hard cap.
+typedef struct arena_struct {
+	uint8_t* start;     // Base of the reserved address range
+	size_t reserved;    // Bytes of address space reserved (hard cap)
+	size_t committed;   // Bytes accessible so far
+	int huge_pages;     // Ask for transparent huge pages when committing
+} arena_t;
+
+//////////////////////////////////////////////////////////////////////
+// Reserve address space for the given # of bytes without committing it
+
+arena_t arena_reserve(size_t bytes, int huge_pages);
+
+//////////////////////////////////////////////////////////////////////
+// Make sure the first bytes of the arena are committed; return 0 if
+// that would exceed the reservation or the system refuses
+
+int arena_commit(arena_t* a, size_t bytes);
+
+//////////////////////////////////////////////////////////////////////
+// Return the whole reservation to the system
+
+void arena_release(arena_t* a);
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * Microbenchmark for the dead-end check: plays random moves on each
+ * puzzle given, then times the incremental check (dirty cells only)
+ * against the previous one (every free cell within two steps of the
+ * head that moved) on the same states, and checks they agree.
+ *
+ * Build with "make bench", run as ./bench_deadends puzzles/...
+ */
+
+#include "utils.h"
+#include "options.h"
+#include "engine.h"
+#include "extensions.h"
+
+// States sampled per puzzle and timing passes over them
+enum {
+	BENCH_STATES = 20000,
+	BENCH_PASSES = 50
+};
+
+//////////////////////////////////////////////////////////////////////
+// Previous dead-end check: every free cell within two steps of the
+// last head, with the open endpoints rebuilt from the colors
+
+static int check_deadends_near(const game_info_t* info,
+                               const game_state_t* state) {
+
+	size_t color = state->last_color;
+
+	if (color >= info->num_colors) {
+		return 0;
+	}
+
+	bitboard_t near;
+	memset(&near, 0, sizeof(near));
+	bb_set(&near, state->pos[color]);
+
+	for (int step=0; step<2; ++step) {
+		near = bb_and(bb_or(near, bb_dilate(near)), info->board);
+	}
+
+	bitboard_t open;
+	memset(&open, 0, sizeof(open));
+
+	for (size_t c=0; c<info->num_colors; ++c) {
+		if (!(state->completed & (1 << c))) {
+			bb_set(&open, state->pos[c]);
+			bb_set(&open, info->goal_pos[c]);
+		}
+	}
+
+	bitboard_t avail = bb_or(state->free, open);
+
+	bitboard_t one, two;
+	memset(&one, 0, sizeof(one));
+	memset(&two, 0, sizeof(two));
+
+	for (int dir=0; dir<4; ++dir) {
+		bitboard_t n = bb_neighbor(avail, dir);
+		two = bb_or(two, bb_and(one, n));
+		one = bb_or(one, n);
+	}
+
+	return bb_any(bb_andnot(bb_and(state->free, near), two));
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Fill states with the positions met along random playouts from
+// init; a playout ends at the first dead end or when no move is left,
+// so the parent of every state sampled passed the check
+
+static size_t sample_states(const game_info_t* info,
+                            const game_state_t* init,
+                            game_state_t* states, size_t max_states) {
+
+	size_t count = 0;
+
+	while (count < max_states) {
+
+		game_state_t state = *init;
+
+		while (count < max_states &&
+		       state.completed != (1 << info->num_colors) - 1) {
+
+			int color = game_next_move_color(info, &state);
+			int legal_dirs = game_legal_dirs(info, &state, color);
+
+			if (!legal_dirs) {
+				break;
+			}
+
+			int dir;
+			do {
+				dir = rand() % 4;
+			} while (!(legal_dirs & (1 << dir)));
+
+			game_make_move(info, &state, color, dir);
+			states[count++] = state;
+
+			if (check_deadends_near(info, &state)) {
+				break;
+			}
+
+		}
+
+	}
+
+	return count;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Time passes of check over the states; return ns per check and the
+// number of states it flagged in *hits
+
+static double time_check(deadend_fn check, const game_info_t* info,
+                         const game_state_t* states, size_t count,
+                         size_t* hits) {
+
+	double start = now();
+	size_t flagged = 0;
+
+	for (int pass=0; pass<BENCH_PASSES; ++pass) {
+		for (size_t i=0; i<count; ++i) {
+			flagged += check(info, states + i);
+		}
+	}
+
+	*hits = flagged / BENCH_PASSES;
+
+	return (now() - start) * 1e9 / ((double)count * BENCH_PASSES);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Main function
+
+int main(int argc, char** argv) {
+
+	setlocale(LC_NUMERIC, "");
+
+	memset(&g_options, 0, sizeof(g_options));
+	g_options.display_quiet = 1;
+	g_options.order_most_constrained = 1;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: %s PUZZLE ...\n", argv[0]);
+		return 1;
+	}
+
+	game_state_t* states = malloc(BENCH_STATES * sizeof(game_state_t));
+	if (!states) {
+		fprintf(stderr, "out of memory for %d states!\n", BENCH_STATES);
+		exit(1);
+	}
+
+	printf("%-36s %8s %8s %10s %10s %10s %8s %10s\n", "puzzle", "states",
+	       "deadends", "near ns", "dirty ns", "kernel ns",
+	       "patterns", "pattern ns");
+
+	int mismatches = 0;
+
+	for (int i=1; i<argc; ++i) {
+
+		game_info_t info;
+		game_state_t init;
+
+		if (!game_read(argv[i], &info, &init)) {
+			continue;
+		}
+
+		game_order_colors(&info, &init);
+
+		// The whole board is dirty in a state just read
+		if (game_check_deadends(&info, &init)) {
+			printf("%-36s starts with a dead end, skipped\n", argv[i]);
+			continue;
+		}
+
+		srand(1);
+		size_t count = sample_states(&info, &init, states, BENCH_STATES);
+
+		for (size_t s=0; s<count; ++s) {
+			if (check_deadends_near(&info, states + s) !=
+			    game_check_deadends(&info, states + s)) {
+				++mismatches;
+			}
+		}
+
+		size_t near_hits, dirty_hits, kernel_hits, pattern_hits;
+		double near_ns = time_check(check_deadends_near, &info,
+		                            states, count, &near_hits);
+		double dirty_ns = time_check(game_check_deadends, &info,
+		                             states, count, &dirty_hits);
+		double kernel_ns = time_check(game_deadend_kernel(&info), &info,
+		                              states, count, &kernel_hits);
+
+		// Patterns catch every dead end and more, so only the prune
+		// rate and cost are compared
+		double pattern_ns = time_check(game_check_patterns, &info,
+		                               states, count, &pattern_hits);
+
+		printf("%-36s %'8zu %'8zu %10.2f %10.2f %10.2f %'8zu %10.2f\n",
+		       argv[i], count, near_hits, near_ns, dirty_ns, kernel_ns,
+		       pattern_hits, pattern_ns);
+
+		if (dirty_hits != near_hits || kernel_hits != near_hits ||
+		    pattern_hits < near_hits) {
+			++mismatches;
+		}
+
+	}
+
+	free(states);
+
+	if (mismatches) {
+		printf("\n%d disagreements between the checks!\n", mismatches);
+		return 1;
+	}
+
+	return 0;
+
+}
@@ -0,0 +1,204 @@
+#ifndef __BITBOARD__
+#define __BITBOARD__
+
+#include <stdint.h>
+#include <string.h>
+
+//////////////////////////////////////////////////////////////////////
+// 256-bit board with one bit per 8-bit position: bit (pos & 63) of
+// word (pos >> 6). Rows are 16 bits apart, so the four neighbors of
+// every cell are shifts by 1 and 16. Column 15 is never on the board,
+// which keeps horizontal shifts from leaking across rows as long as
+// operands only hold on-board bits.
+//
+// These are used in the innermost loops of the engine, hence inline.
+//
+// Words past the ones a board needs are all zero and stay zero.
+
+enum {
+	BB_WORDS = 4,
+	BB_BITS  = 64*BB_WORDS
+};
+
+typedef struct bitboard_struct {
+	uint64_t w[BB_WORDS];
+} bitboard_t;
+
+//////////////////////////////////////////////////////////////////////
+// Is the bit for pos set? Positions outside 0..255 read as clear.
+
+static inline int bb_test(const bitboard_t* b, int pos) {
+	return (unsigned)pos < BB_BITS && ((b->w[pos >> 6] >> (pos & 63)) & 1);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Set / clear the bit for pos
+
+static inline void bb_set(bitboard_t* b, int pos) {
+	b->w[pos >> 6] |= (uint64_t)1 << (pos & 63);
+}
+
+static inline void bb_clear(bitboard_t* b, int pos) {
+	b->w[pos >> 6] &= ~((uint64_t)1 << (pos & 63));
+}
+
+// Every operation below also comes in a _w form that only touches the
+// first words words; a board of size n fits in ceil(n/4) words, and
+// kernels instantiated for a size pass that as a constant.
+#define BB_INLINE static inline __attribute__((always_inline))
+
+//////////////////////////////////////////////////////////////////////
+// Move every bit up (towards higher positions) by n, 0 < n < 64
+
+BB_INLINE bitboard_t bb_shl_w(bitboard_t b, int n, int words) {
+	bitboard_t r = b;
+	for (int i=words-1; i>0; --i) {
+		r.w[i] = (b.w[i] << n) | (b.w[i-1] >> (64-n));
+	}
+	r.w[0] = b.w[0] << n;
+	return r;
+}
+
+BB_INLINE bitboard_t bb_shl(bitboard_t b, int n) {
+	return bb_shl_w(b, n, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Move every bit down (towards lower positions) by n, 0 < n < 64
+
+BB_INLINE bitboard_t bb_shr_w(bitboard_t b, int n, int words) {
+	bitboard_t r = b;
+	for (int i=0; i<words-1; ++i) {
+		r.w[i] = (b.w[i] >> n) | (b.w[i+1] << (64-n));
+	}
+	r.w[words-1] = b.w[words-1] >> n;
+	return r;
+}
+
+BB_INLINE bitboard_t bb_shr(bitboard_t b, int n) {
+	return bb_shr_w(b, n, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bitwise and / or / and-not (a & ~b)
+
+BB_INLINE bitboard_t bb_and_w(bitboard_t a, bitboard_t b, int words) {
+	for (int i=0; i<words; ++i) { a.w[i] &= b.w[i]; }
+	return a;
+}
+
+BB_INLINE bitboard_t bb_or_w(bitboard_t a, bitboard_t b, int words) {
+	for (int i=0; i<words; ++i) { a.w[i] |= b.w[i]; }
+	return a;
+}
+
+BB_INLINE bitboard_t bb_andnot_w(bitboard_t a, bitboard_t b, int words) {
+	for (int i=0; i<words; ++i) { a.w[i] &= ~b.w[i]; }
+	return a;
+}
+
+BB_INLINE bitboard_t bb_and(bitboard_t a, bitboard_t b) {
+	return bb_and_w(a, b, BB_WORDS);
+}
+
+BB_INLINE bitboard_t bb_or(bitboard_t a, bitboard_t b) {
+	return bb_or_w(a, b, BB_WORDS);
+}
+
+BB_INLINE bitboard_t bb_andnot(bitboard_t a, bitboard_t b) {
+	return bb_andnot_w(a, b, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Any bit set?
+
+BB_INLINE int bb_any_w(bitboard_t b, int words) {
+	uint64_t any = 0;
+	for (int i=0; i<words; ++i) { any |= b.w[i]; }
+	return any != 0;
+}
+
+BB_INLINE int bb_any(bitboard_t b) {
+	return bb_any_w(b, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Same bits set?
+
+BB_INLINE int bb_equal_w(bitboard_t a, bitboard_t b, int words) {
+	uint64_t diff = 0;
+	for (int i=0; i<words; ++i) { diff |= a.w[i] ^ b.w[i]; }
+	return diff == 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Board holding only the lowest set bit of b (b must not be empty)
+
+BB_INLINE bitboard_t bb_lowest_w(bitboard_t b, int words) {
+	bitboard_t r;
+	memset(&r, 0, sizeof(r));
+	for (int i=0; i<words; ++i) {
+		if (b.w[i]) {
+			r.w[i] = b.w[i] & -b.w[i];
+			break;
+		}
+	}
+	return r;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Number of bits set
+
+static inline int bb_count(bitboard_t b) {
+	return __builtin_popcountll(b.w[0]) + __builtin_popcountll(b.w[1]) +
+		__builtin_popcountll(b.w[2]) + __builtin_popcountll(b.w[3]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Cells with a set neighbor on the left, right, above and below, in
+// the order of the DIR_ enum. Bits that land off the board are left
+// for the caller to mask.
+
+BB_INLINE bitboard_t bb_neighbor_w(bitboard_t b, int dir, int words) {
+	switch (dir) {
+	case 0:  return bb_shl_w(b, 1, words);  // DIR_LEFT: neighbor at pos-1
+	case 1:  return bb_shr_w(b, 1, words);  // DIR_RIGHT: neighbor at pos+1
+	case 2:  return bb_shl_w(b, 16, words); // DIR_UP: neighbor at pos-16
+	default: return bb_shr_w(b, 16, words); // DIR_DOWN: neighbor at pos+16
+	}
+}
+
+BB_INLINE bitboard_t bb_neighbor(bitboard_t b, int dir) {
+	return bb_neighbor_w(b, dir, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Cells with at least one set neighbor (b itself not included)
+
+BB_INLINE bitboard_t bb_dilate_w(bitboard_t b, int words) {
+	return bb_or_w(bb_or_w(bb_shl_w(b, 1, words), bb_shr_w(b, 1, words), words),
+	               bb_or_w(bb_shl_w(b, 16, words), bb_shr_w(b, 16, words), words),
+	               words);
+}
+
+BB_INLINE bitboard_t bb_dilate(bitboard_t b) {
+	return bb_dilate_w(b, BB_WORDS);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Cells of within connected to the cells of seed that lie in it
+
+BB_INLINE bitboard_t bb_flood_w(bitboard_t seed, bitboard_t within,
+                                int words) {
+	bitboard_t region = bb_and_w(seed, within, words);
+	while (1) {
+		bitboard_t grown = bb_and_w(bb_or_w(region,
+		                                    bb_dilate_w(region, words),
+		                                    words),
+		                            within, words);
+		if (bb_equal_w(grown, region, words)) { return region; }
+		region = grown;
+	}
+}
+
+#endif
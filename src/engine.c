@@ -2,6 +2,56 @@
 #include "utils.h"
 #include "options.h"
 
+//////////////////////////////////////////////////////////////////////
+// Zobrist keys: one per (position, cell value), one per (color, end
+// position) and one per completed color. Filled once by game_hash_init.
+
+static uint64_t zobrist_cells[MAX_CELLS][256];
+static uint64_t zobrist_heads[MAX_COLORS][256];
+static uint64_t zobrist_completed[MAX_COLORS];
+static int zobrist_ready = 0;
+
+//////////////////////////////////////////////////////////////////////
+// Fixed-seed xorshift generator so hashes are reproducible across runs
+
+static uint64_t zobrist_next(uint64_t* seed) {
+
+	uint64_t x = *seed;
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*seed = x;
+	return x;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Fill the Zobrist key tables (free cells hash to zero)
+
+static void game_hash_init() {
+
+	if (zobrist_ready) { return; }
+
+	uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+	for (size_t pos=0; pos<MAX_CELLS; ++pos) {
+		zobrist_cells[pos][0] = 0;
+		for (size_t cell=1; cell<256; ++cell) {
+			zobrist_cells[pos][cell] = zobrist_next(&seed);
+		}
+	}
+
+	for (size_t color=0; color<MAX_COLORS; ++color) {
+		for (size_t pos=0; pos<256; ++pos) {
+			zobrist_heads[color][pos] = zobrist_next(&seed);
+		}
+		zobrist_completed[color] = zobrist_next(&seed);
+	}
+
+	zobrist_ready = 1;
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Print out game board
 
@@ -35,6 +85,63 @@ void game_print(const game_info_t* info,
 }
 
 
+//////////////////////////////////////////////////////////////////////
+// Free directions of the head of color, as stored in free_dirs
+
+static int head_free_dirs(const game_state_t* state, int color) {
+	return (state->free_dirs >> (4*color)) & 0xf;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free directions around pos, from the free bitboard. The bitboard
+// only holds on-board cells, so off-board neighbors (column 15, rows
+// past the bottom, negative positions) read as occupied.
+
+static int pos_free_dirs(const game_state_t* state, pos_t pos) {
+
+	int dirs = 0;
+
+	for (int dir=0; dir<4; ++dir) {
+		dirs |= bb_test(&state->free, pos + DIR_DELTA[dir][2]) << dir;
+	}
+
+	return dirs;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// All puzzles are designed so that a new path segment is adjacent
+// to at most one path segment of the same color -- the predecessor
+// to the new segment (or the other end, which completes the path).
+// Check whether new_pos would break that.
+
+static int touches_own_path(const game_info_t* info,
+                            const game_state_t* state,
+                            int color, pos_t new_pos) {
+
+	for (int dir=0; dir<4; ++dir) {
+
+		// Look up position
+		pos_t neighbor_pos = info->neighbors[new_pos][dir];
+
+		// If occupied cell on the board and not either end and has
+		// our color, then fail
+		if ( neighbor_pos != INVALID_POS &&
+		     !bb_test(&state->free, neighbor_pos) &&
+		     neighbor_pos != state->pos[color] && 
+		     neighbor_pos != state->end[color] && 
+		     cell_get_color(state->cells[neighbor_pos]) == color) {
+
+			return 1;
+
+		}
+    
+	}
+
+	return 0;
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Consider whether the given move is valid.
 
@@ -47,61 +154,137 @@ int game_can_move(const game_info_t* info,
 
 	assert(!(state->completed & (1 << color)));
 
-	// Get cur pos x, y
-	int cur_x, cur_y;
-	pos_get_coords(state->pos[color], &cur_x, &cur_y);
+	// Must be empty (TYPE_FREE), which also rules out leaving the board
+	if (!(head_free_dirs(state, color) & (1 << dir))) {
+		return 0;
+	}
+
+	pos_t new_pos = state->pos[color] + DIR_DELTA[dir][2];
+  
+	// It's valid unless it runs alongside its own path
+	return !touches_own_path(info, state, color, new_pos);
 
-	// Get new x, y
-	int new_x = cur_x + DIR_DELTA[dir][0];
-	int new_y = cur_y + DIR_DELTA[dir][1];
+}
 
-	// If outside bounds, not legal
-	if (new_x < 0 || new_x >= info->size ||
-	    new_y < 0 || new_y >= info->size) {
-		return 0;
+//////////////////////////////////////////////////////////////////////
+// Drop the free directions dirs around pos, an end of color, that
+// would run alongside its own path
+
+static int legal_dirs_from(const game_info_t* info,
+                           const game_state_t* state,
+                           int color, pos_t pos, int dirs) {
+
+	for (int dir=0; dir<4; ++dir) {
+		if ((dirs & (1 << dir)) &&
+		    touches_own_path(info, state, color, pos + DIR_DELTA[dir][2])) {
+			dirs &= ~(1 << dir);
+		}
 	}
 
-	// Create a new position
-	pos_t new_pos = pos_from_coords(new_x, new_y);
-	assert( new_pos < MAX_CELLS );
+	return dirs;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Directions the given color can move in, as a 4-bit mask
+
+int game_legal_dirs(const game_info_t* info,
+                    const game_state_t* state,
+                    int color) {
+
+	assert(color < info->num_colors);
+
+	assert(!(state->completed & (1 << color)));
+
+	return legal_dirs_from(info, state, color, state->pos[color],
+	                       head_free_dirs(state, color));
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Directions the other end of the given color (state->end) could
+// grow in, as a 4-bit mask
 
-       
-	// Must be empty (TYPE_FREE)
-	if (state->cells[new_pos]) {
+int game_end_legal_dirs(const game_info_t* info,
+                        const game_state_t* state,
+                        int color) {
+
+	assert(color < info->num_colors);
+
+	assert(!(state->completed & (1 << color)));
+
+	pos_t end = state->end[color];
+
+	return legal_dirs_from(info, state, color, end,
+	                       pos_free_dirs(state, end));
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Swap the head and the other end of color, so that the next moves of
+// color grow its path from the other end; recorded in log (if not
+// NULL) for game_undo_moves
+
+void game_swap_ends(const game_info_t* info, game_state_t* state,
+                    int color, game_undo_log_t* log) {
+
+	assert(!(state->completed & (1 << color)));
+
+	if (log) {
+		assert(log->count < 2*MAX_CELLS);
+		game_undo_t* undo = log->moves + log->count++;
+		undo->color = color;
+		undo->last_color = state->last_color;
+		undo->next_color = state->next_color;
+		undo->swap = 1;
+	}
+
+	// Both ends stay open and hash alike; only the head's free
+	// directions change
+	pos_t head = state->pos[color];
+	state->pos[color] = state->end[color];
+	state->end[color] = head;
+
+	state->free_dirs &= ~((uint64_t)0xf << (4*color));
+	state->free_dirs |= (uint64_t)pos_free_dirs(state, state->pos[color])
+		<< (4*color);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// With -b, whether color should grow from its other end next: when
+// the color is picked afresh (it did not make the last move), that
+// end has fewer legal moves than the head. A color keeps growing
+// the end it started on; switching back and forth searches more.
+
+int game_pick_end(const game_info_t* info, const game_state_t* state,
+                  int color) {
+
+	if (!g_options.order_both_ends || state->last_color == color) {
 		return 0;
 	}
 
+	return __builtin_popcount(game_end_legal_dirs(info, state, color)) <
+		__builtin_popcount(game_legal_dirs(info, state, color));
 
-	// All puzzles are designed so that a new path segment is adjacent
-	// to at most one path segment of the same color -- the predecessor
-	// to the new segment. We check this by iterating over the
-	// neighbors.
-	for (int dir=0; dir<4; ++dir) {
+}
 
-		// Assemble position
-		pos_t neighbor_pos = offset_pos(info, new_x, new_y, dir);
 
-		// If valid non-empty cell and not cur_pos and not goal_pos and
-		// has our color, then fail
-		if ( neighbor_pos != INVALID_POS && 
-		     state->cells[neighbor_pos] &&
-		     neighbor_pos != state->pos[color] && 
-		     neighbor_pos != info->goal_pos[color] && 
-		     cell_get_color(state->cells[neighbor_pos]) == color) {
+//////////////////////////////////////////////////////////////////////
+// Set the bits of the on-board neighbors of pos
 
-			return 0;
+static inline void mark_neighbors(const game_info_t* info, bitboard_t* b,
+                                  pos_t pos) {
 
+	for (int dir=0; dir<4; ++dir) {
+		pos_t neighbor_pos = info->neighbors[pos][dir];
+		if (neighbor_pos != INVALID_POS) {
+			bb_set(b, neighbor_pos);
 		}
-    
 	}
-	
-  
-	// It's valid
-	return 1;
 
 }
 
-
 //////////////////////////////////////////////////////////////////////
 // Update the game state to make the given move.
 
@@ -116,36 +299,64 @@ void game_make_move(const game_info_t* info,
 	// Update the cell with the new cell value
 	cell_t move = cell_create(TYPE_PATH, color, dir);
   
-	// Get current x, y
-	int cur_x, cur_y;
-	pos_get_coords(state->pos[color], &cur_x, &cur_y);
-
-	// Assemble new x, y
-	int new_x = cur_x + DIR_DELTA[dir][0];
-	int new_y = cur_y + DIR_DELTA[dir][1];
-
-	// Make sure valid
-	assert( new_x >= 0 && new_x < (int)info->size &&
-		new_y >= 0 && new_y < (int)info->size );
-
 	// Make position
-	pos_t new_pos = pos_from_coords(new_x, new_y);
-	assert( new_pos < MAX_CELLS );
+	pos_t old_pos = state->pos[color];
+	pos_t new_pos = old_pos + DIR_DELTA[dir][2];
 
-	// Make sure it's empty
+	// Make sure it's on the board and empty
+	assert( bb_test(&state->free, new_pos) );
 	assert( state->cells[new_pos] == 0 );
 
 	// Update cells and new pos
+	state->hash ^= zobrist_cells[new_pos][move];
+	state->hash ^= zobrist_heads[color][state->pos[color]];
+	state->hash ^= zobrist_heads[color][new_pos];
+
 	state->cells[new_pos] = move;
+	bb_clear(&state->free, new_pos);
 	state->pos[color] = new_pos;
 	--state->num_free;
 
+	// The new cell is no longer free for any head next to it; the head
+	// that moved sees a new neighborhood
+	for (int dir=0; dir<4; ++dir) {
+
+		pos_t neighbor_pos = info->neighbors[new_pos][dir];
+
+		if (neighbor_pos != INVALID_POS &&
+		    !bb_test(&state->free, neighbor_pos)) {
+
+			int neighbor_color = cell_get_color(state->cells[neighbor_pos]);
+
+			if (state->pos[neighbor_color] == neighbor_pos) {
+				state->free_dirs &= ~((uint64_t)1 << (4*neighbor_color + (dir^1)));
+			}
+
+		}
+
+	}
+
+	state->free_dirs &= ~((uint64_t)0xf << (4*color));
+	state->free_dirs |= (uint64_t)pos_free_dirs(state, new_pos) << (4*color);
+
+	// The new cell stays open as the head; the old head is closed for
+	// good, so only its neighbors lose a way in or out. The neighbors
+	// of the new cell see it turn from free into a head.
+	bb_clear(&state->open, old_pos);
+	bb_set(&state->open, new_pos);
+
+	memset(&state->dirty, 0, sizeof(state->dirty));
+	mark_neighbors(info, &state->dirty, old_pos);
+	mark_neighbors(info, &state->dirty, new_pos);
+
 	state->last_color = color;
+	state->next_color = MAX_COLORS;
 
+	pos_t end = state->end[color];
 	int goal_dir = -1;
 
 	for (int dir=0; dir<4; ++dir) {
-		if (offset_pos(info, new_x, new_y, dir) == info->goal_pos[color]) {
+		if (info->neighbors[new_pos][dir] == end) {
 			goal_dir = dir;
 			break;
 		}
@@ -153,15 +364,244 @@ void game_make_move(const game_info_t* info,
 	
 	if (goal_dir >= 0) {
 
-		state->cells[info->goal_pos[color]] = cell_create(TYPE_GOAL, color, 
-        goal_dir);
+		// An end that never moved is the goal (or, with -b, the start)
+		// cell; it records the direction the path came in from
+		cell_t end_cell = state->cells[end];
+		int end_type = cell_get_type(end_cell);
+
+		if (end_type != TYPE_PATH) {
+			cell_t goal_cell = cell_create(end_type, color, goal_dir);
+			state->hash ^= zobrist_cells[end][end_cell];
+			state->hash ^= zobrist_cells[end][goal_cell];
+			state->cells[end] = goal_cell;
+		}
+
+		state->hash ^= zobrist_completed[color];
 
 		state->completed |= (1 << color);    
+
+		// Head and goal both close once the path is complete
+		bb_clear(&state->open, new_pos);
+		bb_clear(&state->open, end);
+
+		mark_neighbors(info, &state->dirty, end);
+
 	} 
 
 }
 
 
+//////////////////////////////////////////////////////////////////////
+// Make the given move and record it in log (if not NULL) so that
+// game_undo_moves can take it back
+
+void game_make_logged_move(const game_info_t* info, game_state_t* state,
+                           int color, int dir, game_undo_log_t* log) {
+
+	if (log) {
+		assert(log->count < 2*MAX_CELLS);
+		game_undo_t* undo = log->moves + log->count++;
+		undo->color = color;
+		undo->last_color = state->last_color;
+		undo->next_color = state->next_color;
+		undo->swap = 0;
+	}
+
+	game_make_move(info, state, color, dir);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Take back the last move made on state, recorded in undo. The dirty
+// cells are the ones next to the cells it gave back.
+
+void game_unmake_move(const game_info_t* info, game_state_t* state,
+                      const game_undo_t* undo) {
+
+	int color = undo->color;
+
+	memset(&state->dirty, 0, sizeof(state->dirty));
+
+	// Swapping the ends back is its own undo
+	if (undo->swap) {
+		game_swap_ends(info, state, color, NULL);
+		state->last_color = undo->last_color;
+		return;
+	}
+
+	// The head sits on the cell the move filled, and the cell says
+	// which way the move went
+	pos_t new_pos = state->pos[color];
+	cell_t move = state->cells[new_pos];
+	pos_t old_pos = new_pos - DIR_DELTA[cell_get_direction(move)][2];
+
+	assert(cell_get_type(move) == TYPE_PATH);
+	assert(cell_get_color(move) == color);
+
+	// Only the move can have completed its color, since a completed
+	// color never moves
+	if (state->completed & (1 << color)) {
+
+		pos_t end = state->end[color];
+		cell_t end_cell = state->cells[end];
+		int end_type = cell_get_type(end_cell);
+
+		if (end_type != TYPE_PATH) {
+			cell_t goal_cell = cell_create(end_type, color, 0);
+			state->hash ^= zobrist_cells[end][end_cell];
+			state->hash ^= zobrist_cells[end][goal_cell];
+			state->cells[end] = goal_cell;
+		}
+
+		state->hash ^= zobrist_completed[color];
+		state->completed &= ~(1 << color);
+
+		bb_set(&state->open, end);
+
+		mark_neighbors(info, &state->dirty, end);
+
+	}
+
+	state->hash ^= zobrist_cells[new_pos][move];
+	state->hash ^= zobrist_heads[color][new_pos];
+	state->hash ^= zobrist_heads[color][old_pos];
+
+	state->cells[new_pos] = 0;
+	bb_set(&state->free, new_pos);
+	state->pos[color] = old_pos;
+	++state->num_free;
+
+	bb_clear(&state->open, new_pos);
+	bb_set(&state->open, old_pos);
+
+	// The freed cell is a free direction again for the heads next to
+	// it, the old head among them
+	for (int dir=0; dir<4; ++dir) {
+
+		pos_t neighbor_pos = info->neighbors[new_pos][dir];
+
+		if (neighbor_pos != INVALID_POS &&
+		    !bb_test(&state->free, neighbor_pos)) {
+
+			int neighbor_color = cell_get_color(state->cells[neighbor_pos]);
+
+			if (state->pos[neighbor_color] == neighbor_pos) {
+				state->free_dirs |= (uint64_t)1 << (4*neighbor_color + (dir^1));
+			}
+
+		}
+
+	}
+
+	state->free_dirs &= ~((uint64_t)0xf << (4*color));
+	state->free_dirs |= (uint64_t)pos_free_dirs(state, old_pos) << (4*color);
+
+	mark_neighbors(info, &state->dirty, old_pos);
+	mark_neighbors(info, &state->dirty, new_pos);
+
+	state->last_color = undo->last_color;
+	state->next_color = undo->next_color;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Take back the moves of log past the first count; the dirty cells
+// cover all of them
+
+void game_undo_moves(const game_info_t* info, game_state_t* state,
+                     game_undo_log_t* log, size_t count) {
+
+	bitboard_t dirty;
+	memset(&dirty, 0, sizeof(dirty));
+
+	while (log->count > count) {
+		game_unmake_move(info, state, log->moves + --log->count);
+		dirty = bb_or(dirty, state->dirty);
+	}
+
+	state->dirty = dirty;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the free-cell bitboard from the cells
+
+void game_update_free(const game_info_t* info, game_state_t* state) {
+
+	memset(&state->free, 0, sizeof(state->free));
+
+	for (size_t y=0; y<info->size; ++y) {
+
+		// A row is 16 bits, so it never straddles two words
+		uint64_t row = 0;
+		const cell_t* cells = state->cells + (y << 4);
+
+		for (size_t x=0; x<info->size; ++x) {
+			row |= (uint64_t)(cells[x] == 0) << x;
+		}
+
+		state->free.w[y >> 2] |= row << ((y & 3) << 4);
+
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the free directions of every head from the free bitboard
+
+void game_update_free_dirs(const game_info_t* info, game_state_t* state) {
+
+	state->free_dirs = 0;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		state->free_dirs |= (uint64_t)pos_free_dirs(state, state->pos[color])
+			<< (4*color);
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the open endpoints from the heads and completed flags
+
+void game_update_open(const game_info_t* info, game_state_t* state) {
+
+	memset(&state->open, 0, sizeof(state->open));
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (!(state->completed & (1 << color))) {
+			bb_set(&state->open, state->pos[color]);
+			bb_set(&state->open, state->end[color]);
+		}
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Compute the Zobrist hash of a state from scratch
+
+uint64_t game_hash_state(const game_info_t* info,
+                         const game_state_t* state) {
+
+	game_hash_init();
+
+	uint64_t hash = 0;
+
+	for (size_t pos=0; pos<MAX_CELLS; ++pos) {
+		hash ^= zobrist_cells[pos][state->cells[pos]];
+	}
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		hash ^= zobrist_heads[color][state->pos[color]];
+		hash ^= zobrist_heads[color][state->end[color]];
+		if (state->completed & (1 << color)) {
+			hash ^= zobrist_completed[color];
+		}
+	}
+
+	return hash;
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Pick the next color to move deterministically
 
@@ -178,12 +618,19 @@ int game_next_move_color(const game_info_t* info,
         
 	}
 
+	// The domain check may have picked one (see game_check_domains)
+	if (state->next_color < info->num_colors &&
+	    !(state->completed & (1 << state->next_color))) {
+		return state->next_color;
+	}
+
 	// return the color with less number of free cells
 	// Do not return a color which is already completed!
 	if ( g_options.order_most_constrained) {
 
+		// Every head has at most 4 free neighbors
 		size_t best_color = -1;
-		int best_free = 4;
+		int best_free = 5;
 
 		
 		for (size_t i=0; i<info->num_colors; ++i) {
@@ -194,8 +641,14 @@ int game_next_move_color(const game_info_t* info,
 				continue;
 			}
       
-			int num_free = game_num_free_pos(info, state,
-							 state->pos[color]);
+			int num_free = __builtin_popcount(head_free_dirs(state, color));
+
+			// With -b the other end may be the tighter one
+			if (g_options.order_both_ends) {
+				int end_free = __builtin_popcount(
+					pos_free_dirs(state, state->end[color]));
+				if (end_free < num_free) { num_free = end_free; }
+			}
 
 			if (num_free < best_free) {
 				best_free = num_free;
@@ -230,21 +683,7 @@ int game_num_free_coords(const game_info_t* info,
                          const game_state_t* state,
                          int x, int y) {
 
-	int num_free = 0;
-  
-	for (int dir=0; dir<4; ++dir) {
-
-		pos_t neighbor_pos = offset_pos(info, x, y, dir);
-
-		if (neighbor_pos != INVALID_POS &&
-		    state->cells[neighbor_pos] == 0) {
-
-			++num_free;
-
-		}
-	}
-
-	return num_free;
+	return game_num_free_pos(info, state, pos_from_coords(x, y));
 
 }
 
@@ -255,10 +694,11 @@ int game_num_free_pos(const game_info_t* info,
                       const game_state_t* state,
                       pos_t pos) {
 
-	int x, y;
+	// Off-board neighbors are never free (see game_can_move)
+	const bitboard_t* free = &state->free;
 
-	pos_get_coords(pos, &x, &y);
-	return game_num_free_coords(info, state, x, y);
+	return bb_test(free, pos - 1) + bb_test(free, pos + 1) +
+		bb_test(free, pos - 16) + bb_test(free, pos + 16);
 
 }
 
@@ -270,12 +710,42 @@ int game_is_free(const game_info_t* info,
                  int x, int y) {
 
 	return (coords_valid(info, x, y) &&
-		state->cells[pos_from_coords(x, y)] == 0);
+		bb_test(&state->free, pos_from_coords(x, y)));
   
 }
 
 
 
+//////////////////////////////////////////////////////////////////////
+// Build the board mask and the per-position neighbor tables once the
+// size is known, so the kernels never decompose positions into x/y
+
+static void game_build_tables(game_info_t* info) {
+
+	memset(info->neighbors, INVALID_POS, sizeof(info->neighbors));
+	memset(info->num_neighbors, 0, sizeof(info->num_neighbors));
+	memset(info->wall_dist, 0, sizeof(info->wall_dist));
+	memset(&info->board, 0, sizeof(info->board));
+
+	for (size_t y=0; y<info->size; ++y) {
+		for (size_t x=0; x<info->size; ++x) {
+
+			pos_t pos = pos_from_coords(x, y);
+
+			bb_set(&info->board, pos);
+			info->wall_dist[pos] = get_wall_dist(info, x, y);
+
+			for (int dir=0; dir<4; ++dir) {
+				pos_t neighbor_pos = offset_pos(info, x, y, dir);
+				info->neighbors[pos][dir] = neighbor_pos;
+				info->num_neighbors[pos] += (neighbor_pos != INVALID_POS);
+			}
+
+		}
+	}
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Helper function for below.
 
@@ -318,6 +788,7 @@ int game_read(const char* filename,
 	memset(state->pos, 0xff, sizeof(state->pos));
 
 	state->last_color = MAX_COLORS;
+	state->next_color = MAX_COLORS;
 
 	size_t y=0;
 
@@ -437,6 +908,8 @@ int game_read(const char* filename,
 		return 0;
 	}
 
+	game_build_tables(info);
+
 	for (size_t color=0; color<info->num_colors; ++color) {
 
 		if (info->goal_pos[color] == INVALID_POS) {
@@ -451,8 +924,8 @@ int game_read(const char* filename,
 		//Makes sure the initial position is closer to the wall,
 		//and the goal position is further from the wall.
 		//This is not neccessary, but deterministically sets where to start the path
-		int init_dist = pos_get_wall_dist(info, info->init_pos[color]);
-		int goal_dist = pos_get_wall_dist(info, info->goal_pos[color]);
+		int init_dist = info->wall_dist[info->init_pos[color]];
+		int goal_dist = info->wall_dist[info->goal_pos[color]];
 		
 		if (goal_dist < init_dist) {
 			pos_t tmp_pos = info->init_pos[color];
@@ -463,14 +936,76 @@ int game_read(const char* filename,
 				state->pos[color] = info->init_pos[color];
 		}
 
-		
+		state->end[color] = info->goal_pos[color];
 
 	}
+
+	game_update_free(info, state);
+	game_update_free_dirs(info, state);
+	game_update_open(info, state);
+
+	// Nothing has been checked for dead ends yet
+	state->dirty = info->board;
+
+	state->hash = game_hash_state(info, state);
   
 	return 1;
 
 }
 
+//////////////////////////////////////////////////////////////////////
+// Print an SVG subpath that starts at start, steps to pos if that is
+// a different (neighboring) cell, then follows the path back from pos
+// to its endpoint
+
+static void svg_path_from(FILE* fp, const game_info_t* info,
+                          const game_state_t* state, pos_t start, pos_t pos,
+                          size_t m, int xy_skip, size_t cell_size) {
+
+	int x, y;
+	pos_get_coords(start, &x, &y);
+
+	double px = m + xy_skip*x + 0.5*cell_size;
+	double py = m + xy_skip*y + 0.5*cell_size;
+
+	fprintf(fp, "M %g,%g ", px, py);
+
+	// Each path cell records the direction it was entered from, so
+	// the way back is the opposite one
+	pos_t cur = start;
+	int dir = -1;
+
+	for (int d=0; d<4; ++d) {
+		if (pos != start && info->neighbors[start][d] == pos) {
+			dir = d;
+		}
+	}
+
+	while (1) {
+
+		if (dir >= 0) {
+			if (dir == DIR_LEFT || dir == DIR_RIGHT) {
+				fprintf(fp, "h %d ", dir == DIR_LEFT ? -xy_skip : xy_skip);
+			} else {
+				fprintf(fp, "v %d ", dir == DIR_UP ? -xy_skip : xy_skip);
+			}
+			cur = info->neighbors[cur][dir];
+		}
+
+		cell_t cell = state->cells[cur];
+
+		if (cell_get_type(cell) != TYPE_PATH) {
+			break;
+		}
+
+		dir = cell_get_direction(cell) ^ 1; // flip direction
+
+		if (info->neighbors[cur][dir] == INVALID_POS) { break; }
+
+	}
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Print out game board as SVG
 
@@ -545,45 +1080,30 @@ void game_print_svg(FILE* fp,
 
 	for (int color=0; color<info->num_colors; ++color) {
 
-		pos_t pos = (state->completed & (1 << color)) ?
-			info->goal_pos[color] : state->pos[color];
-
-		if (pos == info->init_pos[color]) { continue; }
-
-		int x, y;
-		pos_get_coords(pos, &x, &y);
-    
-		double px = m + xy_skip*x + 0.5*cell_size;
-		double py = m + xy_skip*y + 0.5*cell_size;
-
-		fprintf(fp, "  <path d=\"M %g,%g ", px, py);
-
-		while (1) {
-
-			cell_t cell = state->cells[pos];
-			assert( cell_get_color(cell) == color );
-      
-			int dir = cell_get_direction(cell);
-			dir ^= 1; // flip direction
+		pos_t head = state->pos[color];
+		pos_t end = state->end[color];
+		int head_moved = cell_get_type(state->cells[head]) == TYPE_PATH;
+		int end_moved = cell_get_type(state->cells[end]) == TYPE_PATH;
+		int complete = state->completed & (1 << color);
 
-			if (dir == DIR_LEFT || dir == DIR_RIGHT) {
-				fprintf(fp, "h %d ", dir == DIR_LEFT ? -xy_skip : xy_skip);
-			} else {
-				fprintf(fp, "v %d ", dir == DIR_UP ? -xy_skip : xy_skip);
-			}
-      
-			int npos = pos_offset_pos(info, pos, dir);
-			if (npos == INVALID_POS) { break; }
+		if (!head_moved && !end_moved && !complete) { continue; }
 
-			pos = npos;
+		// With -b the path grows from both endpoints: each end leads
+		// back to its own endpoint. A complete path starts at the
+		// other end and steps over to the head to join the two.
+		fprintf(fp, "  <path d=\"");
 
-			if (pos == info->init_pos[color]) {
-				break;
-			}
+		if (complete) {
+			svg_path_from(fp, info, state, end, head, m, xy_skip, cell_size);
+		} else {
+			svg_path_from(fp, info, state, head, head, m, xy_skip, cell_size);
+		}
 
+		if (end_moved) {
+			svg_path_from(fp, info, state, end, end, m, xy_skip, cell_size);
 		}
 
-		fprintf(fp, " \" style=\"stroke: #%s; stroke-width: %g; "
+		fprintf(fp, "\" style=\"stroke: #%s; stroke-width: %g; "
 			"fill: none; stroke-linecap: round\" />\n",
 			color_dict[info->color_ids[color]].fg_rgb,
 			path_radius);
@@ -11,6 +11,8 @@
 #include <math.h>
 #include <time.h>
 
+#include "bitboard.h"
+
 ///////////////////////////////////////////////////////////
 // Positions are 8-bit integers with 4 bits each for y, x.
 enum {
@@ -65,6 +67,16 @@ typedef struct game_info_struct {
 	// Color table for looking up color ID
 	uint8_t color_tbl[128];
 
+	// Positions that lie on the board
+	bitboard_t board;
+
+	// Neighbor of each position in each direction (INVALID_POS off the
+	// board), number of on-board neighbors and distance to the nearest
+	// wall. Built once by game_read.
+	pos_t   neighbors[MAX_CELLS][4];
+	uint8_t num_neighbors[MAX_CELLS];
+	uint8_t wall_dist[MAX_CELLS];
+
   
 } game_info_t;
 
@@ -78,18 +90,48 @@ typedef struct game_state_struct {
 	// (would not be needed for depth-first search).
 	cell_t   cells[MAX_CELLS];
 
+	// Free cells, one bit per position (see bitboard.h). Derived from
+	// cells, kept in step by game_make_move.
+	bitboard_t free;
+
+	// Directions from each color's head that lead to a free cell: bit
+	// dir of nibble color. Derived like free and kept in step with it.
+	uint64_t free_dirs;
+
+	// Heads and goals of the colors not completed yet, the non-free
+	// cells a path can still enter. Derived like free.
+	bitboard_t open;
+
+	// Cells next to a cell that changed in the last game_make_move
+	// (the whole board in a state just read); only these can have
+	// become dead ends.
+	bitboard_t dirty;
+
 	// Head position
 	pos_t    pos[MAX_COLORS];
 
+	// Other end of each color's path: its goal, or with -b the last
+	// cell grown from it (see game_swap_ends)
+	pos_t    end[MAX_COLORS];
+
 	// How many free cells?
 	uint8_t  num_free;
 
 	// Which was the last color / endpoint
 	uint8_t  last_color;
 
+	// Color game_check_domains picked to move next in this state
+	// (MAX_COLORS for none); any move clears it
+	uint8_t  next_color;
+
 	// Bitflag indicating whether each color has been completed or not
-	// (cur_pos is adjacent to goal_pos).
+	// (pos is adjacent to end).
 	uint16_t completed;
+
+	// Zobrist hash of cells, both ends of each path and completed
+	// flags, updated incrementally by game_make_move. The two ends of
+	// a color hash alike, so game_swap_ends leaves it alone.
+	uint64_t hash;
   
 } game_state_t;
 
@@ -103,6 +145,25 @@ enum {
 	TYPE_GOAL = 3  // Goal position
 };
 
+///////////////////////////////////////////////////////
+// Undo record of one game_make_move: the little it overwrote that
+// cannot be worked out from the state it left behind
+typedef struct game_undo_struct {
+	uint8_t color;      // Color that moved
+	uint8_t last_color; // last_color before the move
+	uint8_t next_color; // next_color before the move
+	uint8_t swap;       // Set for a game_swap_ends rather than a move
+} game_undo_t;
+
+///////////////////////////////////////////////////////
+// Moves made on a state, newest last, so they can be taken back in
+// place. Every move fills a free cell, and at most one swap of ends
+// comes before each, so 2*MAX_CELLS records always do.
+typedef struct game_undo_log_struct {
+	game_undo_t moves[2*MAX_CELLS];
+	size_t count;
+} game_undo_log_t;
+
 /////////////////////////////////////////////////////////
 // Enumerate cardinal directions so we can loop over them
 // RIGHT is increasing x, DOWN is increasing y.
@@ -126,12 +187,82 @@ void game_print(const game_info_t* info, const game_state_t* state);
 int game_can_move(const game_info_t* info, const game_state_t* state, int color, 
 				int dir);
 
+//////////////////////////////////////////////////////////////////////
+// Directions the given color can move in, as a 4-bit mask
+
+int game_legal_dirs(const game_info_t* info, const game_state_t* state,
+                    int color);
+
+//////////////////////////////////////////////////////////////////////
+// Directions the other end of the given color (state->end) could
+// grow in, as a 4-bit mask
+
+int game_end_legal_dirs(const game_info_t* info, const game_state_t* state,
+                        int color);
+
+//////////////////////////////////////////////////////////////////////
+// Swap the head and the other end of color, so that the next moves of
+// color grow its path from the other end; recorded in log (if not
+// NULL) for game_undo_moves
+
+void game_swap_ends(const game_info_t* info, game_state_t* state,
+                    int color, game_undo_log_t* log);
+
+//////////////////////////////////////////////////////////////////////
+// With -b, whether color should grow from its other end next: when
+// the color is picked afresh (not continued from the last move), that
+// end has fewer legal moves than the head
+
+int game_pick_end(const game_info_t* info, const game_state_t* state,
+                  int color);
+
 //////////////////////////////////////////////////////////////////////
 // Update the game state to make the given move.
 
 void game_make_move(const game_info_t* info, game_state_t* state, int color, 
 					int dir);
 
+//////////////////////////////////////////////////////////////////////
+// Make the given move and record it in log (if not NULL) so that
+// game_undo_moves can take it back
+
+void game_make_logged_move(const game_info_t* info, game_state_t* state,
+                           int color, int dir, game_undo_log_t* log);
+
+//////////////////////////////////////////////////////////////////////
+// Take back the last move made on state, recorded in undo. The dirty
+// cells are the ones next to the cells it gave back.
+
+void game_unmake_move(const game_info_t* info, game_state_t* state,
+                      const game_undo_t* undo);
+
+//////////////////////////////////////////////////////////////////////
+// Take back the moves of log past the first count; the dirty cells
+// cover all of them
+
+void game_undo_moves(const game_info_t* info, game_state_t* state,
+                     game_undo_log_t* log, size_t count);
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the free-cell bitboard from the cells
+
+void game_update_free(const game_info_t* info, game_state_t* state);
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the free directions of every head from the free bitboard
+
+void game_update_free_dirs(const game_info_t* info, game_state_t* state);
+
+//////////////////////////////////////////////////////////////////////
+// Rebuild the open endpoints from the path ends and completed flags
+
+void game_update_open(const game_info_t* info, game_state_t* state);
+
+//////////////////////////////////////////////////////////////////////
+// Compute the Zobrist hash of a state from scratch
+
+uint64_t game_hash_state(const game_info_t* info, const game_state_t* state);
+
 //////////////////////////////////////////////////////////////////////
 // Pick the next color to move deterministically
 
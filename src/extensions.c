@@ -2,6 +2,7 @@
 
 
 #include "extensions.h"
+#include "patterns.h"
 #include "options.h"
 
 //////////////////////////////////////////////////////////////////////
@@ -59,7 +60,7 @@ void game_order_colors(game_info_t* info,
 			
 			for (int i=0; i<2; ++i) {
 				pos_get_coords(state->pos[color], x+i, y+i);
-				cf[color].wall_dist[i] = get_wall_dist(info, x[i], y[i]);
+				cf[color].wall_dist[i] = info->wall_dist[state->pos[color]];
 			}
 
 			int dx = abs(x[1]-x[0]);
@@ -100,114 +101,1171 @@ void game_order_colors(game_info_t* info,
 	}
 
 }
-////////////////////////////////////////////////////////////////////// 
-// Check if a specific cell is a deadend 
 
-static int cell_is_deadend(const game_info_t* info, const game_state_t* 
-state, pos_t pos);
+//////////////////////////////////////////////////////////////////////
+// Dead-end check on boards that fit in the first words bitboard words
+// (see game_check_deadends below); instantiated per word count
 
-static int cell_is_deadend(const game_info_t* info,
-                    const game_state_t* state,
-                    pos_t pos) {
+KERNEL_INLINE int check_deadends(const game_info_t* info,
+                                 const game_state_t* state,
+                                 const int words) {
 
-  // Ensure that the position of the cell is valid and is not an initial state
-  assert( !state->cells[pos]&& pos != INVALID_POS );
+	// Only free cells that lost a way in or out in the last move can
+	// have become dead ends; the parent state had none
+	bitboard_t candidates = bb_and_w(state->free, state->dirty, words);
 
-  // Get the coordinates of the cell
-  int x, y;
-  pos_get_coords(pos, &x, &y);
-  
-  int free_cells = 0;
+	if (!bb_any_w(candidates, words)) {
+		return 0;
+	}
 
-  for (int dir=0; dir<4; ++dir) {
+	// Cells a path can pass through
+	bitboard_t avail = bb_or_w(state->free, state->open, words);
 
-	// Obtain the coordinates of its neighbouring cells in all four directions
-    pos_t neighbor_pos = offset_pos(info, x, y, dir);
-    
-	// Check if neighbouring cells are free cells
-	// Verify that neighbouring cell is not in an invalid position
-	if (neighbor_pos != INVALID_POS) {
+	// Count available neighbors of every cell up to two at once
+	bitboard_t one, two;
+	memset(&one, 0, sizeof(one));
+	memset(&two, 0, sizeof(two));
 
-      if (!state->cells[neighbor_pos]) {
-        free_cells++;
+	for (int dir=0; dir<4; ++dir) {
+		bitboard_t n = bb_neighbor_w(avail, dir, words);
+		two = bb_or_w(two, bb_and_w(one, n, words), words);
+		one = bb_or_w(one, n, words);
+	}
 
-      } else {
+	// A free cell with at most one way in or out is a dead end
+	bitboard_t deadends = bb_andnot_w(candidates, two, words);
 
-		// Check if cell is not an initial or goal state
-        for (size_t color=0; color<info->num_colors; color++) {
-          if ( (1 << color)& state->completed ) {
-            continue;
-          }
+	return bb_any_w(deadends, words);
 
-		  // Check if cell is painted with path color
-          if (neighbor_pos == info->goal_pos[color] ||
-              neighbor_pos == state->pos[color]) {
-            free_cells++;
-          }
-        }
-                                                                 
-      }
-    }
-  }
+}
 
-  return (free_cells <= 1);
+#define DEADENDS_KERNEL(WORDS)                                          \
+	static int check_deadends_##WORDS(const game_info_t* info,          \
+	                                  const game_state_t* state) {      \
+		return check_deadends(info, state, WORDS);                      \
+	}
 
-}
+DEADENDS_KERNEL(1)
+DEADENDS_KERNEL(2)
+DEADENDS_KERNEL(3)
+DEADENDS_KERNEL(4)
 
 //////////////////////////////////////////////////////////////////////
 // Check for dead-end regions of freespace where there is no way to
 // put an active path into and out of it. Any freespace node which
 // has only one free neighbor represents such a dead end. For the
 // purposes of this check, cur and goal positions count as "free".
+// Only the cells the last move marked dirty are tested.
 
 int game_check_deadends(const game_info_t* info,
                         const game_state_t* state) {
 
+	return check_deadends(info, state, BB_WORDS);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Dead-end check specialized for the board size of info
+
+deadend_fn game_deadend_kernel(const game_info_t* info) {
+
+	// Rows are 16 bits, so a word holds 4 of them
+	switch ((info->size + 3) / 4) {
+	case 1:  return check_deadends_1;
+	case 2:  return check_deadends_2;
+	case 3:  return check_deadends_3;
+	default: return check_deadends_4;
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Class of the cell at pos in a dead pattern (see gen_patterns.c):
+// 0 blocked or off the board, 1 free, 2 open head, 3 open goal (the
+// other end, see game_state_t)
+
+static inline int pattern_class(const game_state_t* state, pos_t pos) {
+
+	// INVALID_POS is column 15, never set in free or open
+	if (!((state->open.w[pos >> 6] >> (pos & 63)) & 1)) {
+		return (state->free.w[pos >> 6] >> (pos & 63)) & 1;
+	}
+
+	return state->end[cell_get_color(state->cells[pos])] == pos ? 3 : 2;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Look up every domino (two adjacent cells and their six other
+// neighbors) that touches a dirty cell in the table of dead patterns
+// made by gen_patterns.c: free cells with too few ways in and out, or
+// short corridors that would join two heads or two goals. Return 1
+// if one of them is dead.
+
+int game_check_patterns(const game_info_t* info,
+                        const game_state_t* state) {
+
+	// A pattern changes only if one of its cells did, and then one of
+	// the two middle cells is next to it
+	bitboard_t dirty = bb_and(state->dirty, info->board);
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		for (uint64_t bits=dirty.w[i]; bits; bits &= bits-1) {
+
+			pos_t x = 64*i + __builtin_ctzll(bits);
+			int cx = pattern_class(state, x);
+
+			// Neighbors of x are shared by its four dominoes
+			int cn[4];
+			for (int dir=0; dir<4; ++dir) {
+				cn[dir] = pattern_class(state, info->neighbors[x][dir]);
+			}
+
+			for (int dir=0; dir<4; ++dir) {
+
+				pos_t y = info->neighbors[x][dir];
+				if (y == INVALID_POS || (!cx && !cn[dir])) {
+					continue;
+				}
+
+				// Sides are the two directions across the domino
+				int side1 = dir < 2 ? 2 : 0, side2 = side1 + 1;
+
+				int index = cx | (cn[dir] << 2) | (cn[side1] << 4) |
+					(pattern_class(state, info->neighbors[y][side1]) << 6) |
+					(cn[side2] << 8) |
+					(pattern_class(state, info->neighbors[y][side2]) << 10) |
+					(cn[dir^1] << 12) |
+					(pattern_class(state, info->neighbors[y][dir]) << 14);
+
+				if ((PATTERN_DEAD[index >> 6] >> (index & 63)) & 1) {
+					return 1;
+				}
+
+			}
+
+		}
+	}
+
+	return 0;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Region check on boards that fit in the first words bitboard words
+// (see game_check_regions below); instantiated per word count
+
+KERNEL_INLINE int check_regions(const game_info_t* info,
+                                const game_state_t* state,
+                                const int words) {
+
+	int live = live_colors(info, state);
+
+	// Colors with head and goal on the border of a common region, or
+	// next to each other (a single move completes those)
+	int connected = 0;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (pos_adjacent(state->pos[color], state->end[color])) {
+			connected |= 1 << color;
+		}
+	}
+
+	bitboard_t left = state->free;
+
+	while (bb_any_w(left, words)) {
+
+		// Flood fill the region of the lowest free cell left
+		bitboard_t region = bb_flood_w(bb_lowest_w(left, words), left,
+		                               words);
+
+		left = bb_andnot_w(left, region, words);
+
+		// Which heads and goals border it
+		bitboard_t border = bb_dilate_w(region, words);
+		int heads = 0, goals = 0;
+
+		for (size_t color=0; color<info->num_colors; ++color) {
+			if (live & (1 << color)) {
+				heads |= bb_test(&border, state->pos[color]) << color;
+				goals |= bb_test(&border, state->end[color]) << color;
+			}
+		}
+
+		if (!(heads & goals)) {
+			return REGIONS_ISOLATED;
+		}
+
+		connected |= heads & goals;
+
+	}
+
+	return (live & ~connected) ? REGIONS_STRANDED : REGIONS_OK;
+
+}
+
+#define REGIONS_KERNEL(WORDS)                                           \
+	static int check_regions_##WORDS(const game_info_t* info,           \
+	                                 const game_state_t* state) {       \
+		return check_regions(info, state, WORDS);                       \
+	}
+
+REGIONS_KERNEL(1)
+REGIONS_KERNEL(2)
+REGIONS_KERNEL(3)
+REGIONS_KERNEL(4)
+
+//////////////////////////////////////////////////////////////////////
+// Split free space into connected regions. Every region must border
+// both the head and the goal of some live color (a path that enters
+// it can only leave at its own goal), and every live color must have
+// its head and goal on the border of a common region.
+
+int game_check_regions(const game_info_t* info,
+                       const game_state_t* state) {
+
+	return check_regions(info, state, BB_WORDS);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Region check specialized for the board size of info
+
+deadend_fn game_regions_kernel(const game_info_t* info) {
+
+	switch ((info->size + 3) / 4) {
+	case 1:  return check_regions_1;
+	case 2:  return check_regions_2;
+	case 3:  return check_regions_3;
+	default: return check_regions_4;
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Depth-first search of every free region with an explicit stack,
+// then the free neighbors of every head and goal
+
+static void cut_search(const game_info_t* info, const game_state_t* state,
+                       cut_search_t* cs) {
+
+	pos_t   stack[MAX_CELLS];
+	uint8_t next_dir[MAX_CELLS];
+
+	memset(cs->pre, 0, sizeof(cs->pre));
+	memset(cs->num_cut_children, 0, sizeof(cs->num_cut_children));
+	cs->num_cuts = 0;
+
+	uint8_t count = 0;
+	uint8_t num_trees = 0;
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		for (uint64_t bits=state->free.w[i]; bits; bits &= bits-1) {
+
+			pos_t root = 64*i + __builtin_ctzll(bits);
+
+			if (cs->pre[root]) {
+				continue;
+			}
+
+			cs->pre[root] = cs->low[root] = ++count;
+			cs->order[count] = root;
+			cs->tree[root] = num_trees;
+			cs->tree_first[num_trees] = count;
+			stack[0] = root;
+			next_dir[0] = 0;
+			size_t depth = 1;
+
+			while (depth) {
+
+				pos_t u = stack[depth-1];
+
+				if (next_dir[depth-1] < 4) {
+
+					pos_t w = info->neighbors[u][next_dir[depth-1]++];
+
+					if (w == INVALID_POS || !bb_test(&state->free, w)) {
+						continue;
+					}
+
+					if (!cs->pre[w]) {
+						cs->pre[w] = cs->low[w] = ++count;
+						cs->order[count] = w;
+						cs->tree[w] = num_trees;
+						stack[depth] = w;
+						next_dir[depth] = 0;
+						++depth;
+					} else if (cs->pre[w] < cs->low[u]) {
+						// The edge back to the parent counts too, which
+						// is harmless for cut cells (>= test below)
+						cs->low[u] = cs->pre[w];
+					}
+
+				} else {
+
+					cs->last[u] = count;
+
+					if (--depth) {
+
+						pos_t p = stack[depth-1];
+
+						if (cs->low[u] < cs->low[p]) {
+							cs->low[p] = cs->low[u];
+						}
+
+						// The root keeps every child here; with a single
+						// child it cuts nothing off and is skipped
+						if (cs->low[u] >= cs->pre[p]) {
+							if (!cs->num_cut_children[p]) {
+								cs->cuts[cs->num_cuts++] = p;
+							}
+							cs->cut_child[p][cs->num_cut_children[p]++] = u;
+						}
+
+					}
+
+				}
+
+			}
+
+			cs->tree_last[num_trees++] = count;
+
+		}
+	}
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		for (int e=0; e<2; ++e) {
+
+			pos_t t = e ? state->end[color] : state->pos[color];
+			uint8_t* pre = cs->end_pre[2*color + e];
+			int num = 0;
+
+			for (int dir=0; dir<4; ++dir) {
+				pos_t w = info->neighbors[t][dir];
+				if (w != INVALID_POS && bb_test(&state->free, w)) {
+					pre[num++] = cs->pre[w];
+				}
+			}
+
+			cs->num_end_pre[2*color + e] = num;
+
+		}
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Sides of the cut cell v that endpoint e (2*color, plus 1 for the
+// goal) borders: bit k for the subtree of the k-th cut child of v,
+// bit 4 for the rest of the region of v and bits 5 and up for other
+// regions
+
+static uint64_t cut_sides(const cut_search_t* cs, pos_t v, int e) {
+
+	uint64_t sides = 0;
+	int tree = cs->tree[v];
 
-	/**
-	 * FILL CODE TO DETECT DEAD-ENDS
-	 */
+	for (int i=0; i<cs->num_end_pre[e]; ++i) {
 
-	// Assign the last color of the path endpoint to current cell
-	size_t color = state->last_color;
+		int n = cs->end_pre[e][i];
+
+		if (n == cs->pre[v]) {
+			continue;
+		}
 
-	// Stop checking if color is invalid
-	if (color >= info->num_colors) {
+		int side = 4;
+
+		if (n < cs->tree_first[tree] || n > cs->tree_last[tree]) {
+			int other = cs->tree[cs->order[n]];
+			side = 5 + (other < 58 ? other : 58);
+		} else if (n > cs->pre[v] && n <= cs->last[v]) {
+			for (int k=0; k<cs->num_cut_children[v]; ++k) {
+				pos_t c = cs->cut_child[v][k];
+				if (cs->pre[c] <= n && n <= cs->last[c]) {
+					side = k;
+					break;
+				}
+			}
+		}
+
+		sides |= (uint64_t)1 << side;
+
+	}
+
+	return sides;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Find the cut cells of the free-cell graph (articulation points, by
+// Tarjan's low-link numbering). Only one path fits through a single
+// cell, so the state is hopeless if two live colors have their head
+// and goal on different sides of the same cut cell. Return 1 then.
+
+int game_check_cuts(const game_info_t* info, const game_state_t* state,
+                    const cut_search_t* done) {
+
+	// Colors that still need a path through free cells
+	int live = live_colors(info, state);
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (pos_adjacent(state->pos[color], state->end[color])) {
+			live &= ~(1 << color);
+		}
+	}
+
+	if (!(live & (live - 1))) {
 		return 0;
 	}
 
-	// Get the position of current cell including coordinates
-	pos_t cur_pos = state->pos[color];
-	int x,y;
-	pos_get_coords(cur_pos,&x,&y);
-	
-	for (int dir=0; dir<4; ++dir) {
-		
-		// Find position neighbouring cells of the current cell in each direction
-		pos_t neighbor_pos = offset_pos(info,x,y,dir);
+	cut_search_t search;
+	const cut_search_t* cs = done;
 
-		// Check if the neighbouring cell is a deadend
-		if (neighbor_pos != INVALID_POS && !state->cells[neighbor_pos] && 
-        cell_is_deadend(info,state,neighbor_pos)) {
-			return 1;
-		} 
+	if (!cs) {
+		cut_search(info, state, &search);
+		cs = &search;
+	}
+
+	for (size_t i=0; i<cs->num_cuts; ++i) {
 
-		// Find position of other cells surrounding each neighbouring cell in all directions
-		int a,b;
-		pos_get_coords(neighbor_pos,&a,&b);
+		pos_t v = cs->cuts[i];
+		int crossing = 0;
 
-		for (int dir=0; dir<4; ++dir) {
-			pos_t neighbor2_pos = offset_pos(info,a,b,dir);
+		// Only a root has nothing below its own number
+		if (cs->num_cut_children[v] == 1 && cs->low[v] == cs->pre[v]) {
+			continue;
+		}
 
-			// Check if any of those cells is a dead end 
-			if (neighbor2_pos != INVALID_POS && !state->cells[neighbor2_pos] && 
-            cell_is_deadend(info,state,neighbor2_pos)) {
+		for (size_t color=0; color<info->num_colors; ++color) {
+
+			if (!(live & (1 << color))) {
+				continue;
+			}
+
+			// No side in common: the path has to go through v
+			if (!(cut_sides(cs, v, 2*color) & cut_sides(cs, v, 2*color + 1)) &&
+			    ++crossing > 1) {
 				return 1;
 			}
-		}	
+
+		}
 
 	}
 
 	return 0;
 
 }
+
+//////////////////////////////////////////////////////////////////////
+// Apply forced moves until none is left: a live color whose head (or
+// with -b, other end) has a single legal direction has to take it,
+// since its legal moves can only shrink. Return the number of moves
+// applied, or -1 if a live color has no legal move left. The dirty
+// cells of state cover all the moves applied and the one before them.
+// The moves go into log, if not NULL.
+
+int game_apply_forced(const game_info_t* info, game_state_t* state,
+                      game_undo_log_t* log) {
+
+	bitboard_t dirty = state->dirty;
+	int applied = 0;
+	int progress = 1;
+
+	while (progress) {
+
+		progress = 0;
+
+		for (size_t color=0; color<info->num_colors; ++color) {
+
+			if (state->completed & (1 << color)) {
+				continue;
+			}
+
+			// A head next to its goal is done in all but name
+			if (pos_adjacent(state->pos[color], state->end[color])) {
+				continue;
+			}
+
+			int legal_dirs = game_legal_dirs(info, state, color);
+
+			if (!legal_dirs) {
+				state->dirty = dirty;
+				return -1;
+			}
+
+			// With -b the other end is held to the same rule; it
+			// becomes the head to take its forced move
+			if ((legal_dirs & (legal_dirs - 1)) && g_options.order_both_ends) {
+
+				int end_dirs = game_end_legal_dirs(info, state, color);
+
+				if (!end_dirs) {
+					state->dirty = dirty;
+					return -1;
+				}
+
+				if (!(end_dirs & (end_dirs - 1))) {
+					game_swap_ends(info, state, color, log);
+					legal_dirs = end_dirs;
+				}
+
+			}
+
+			if (!(legal_dirs & (legal_dirs - 1))) {
+
+				game_make_logged_move(info, state, color,
+				                      __builtin_ctz(legal_dirs), log);
+				dirty = bb_or(dirty, state->dirty);
+
+				++applied;
+				progress = 1;
+
+			}
+
+		}
+
+	}
+
+	state->dirty = dirty;
+
+	return applied;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Keep only the colors in usable for the cells on side k of the cut
+// cell v (see cut_sides above)
+
+static void narrow_side(const cut_search_t* cs, pos_t v, int k,
+                        uint16_t usable, uint16_t* domains) {
+
+	if (k < 4) {
+
+		pos_t c = cs->cut_child[v][k];
+
+		for (int n=cs->pre[c]; n<=cs->last[c]; ++n) {
+			domains[cs->order[n]] &= usable;
+		}
+
+		return;
+
+	}
+
+	// The rest of the region: everything but v and its cut children,
+	// whose subtrees are runs of preorder numbers in increasing order
+	int tree = cs->tree[v];
+	int n = cs->tree_first[tree];
+
+	for (int i=0; i<=cs->num_cut_children[v]; ++i) {
+
+		int stop = cs->tree_last[tree] + 1;
+
+		if (i < cs->num_cut_children[v]) {
+			stop = cs->pre[cs->cut_child[v][i]];
+		}
+
+		for (; n<stop; ++n) {
+			if (n != cs->pre[v]) {
+				domains[cs->order[n]] &= usable;
+			}
+		}
+
+		if (i < cs->num_cut_children[v]) {
+			n = cs->last[cs->cut_child[v][i]] + 1;
+		}
+
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Domain check on boards that fit in the first words bitboard words
+// (see game_check_domains below); instantiated per word count
+
+KERNEL_INLINE int check_domains(const game_info_t* info,
+                                game_state_t* state,
+                                cut_search_t* cs,
+                                const int words) {
+
+	int live = live_colors(info, state);
+
+	// Live colors with the head next to the goal need no cell
+	int done = 0;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (pos_adjacent(state->pos[color], state->end[color])) {
+			done |= 1 << color;
+		}
+	}
+
+	// Colors that can still take each free cell, and the colors of
+	// its region
+	uint16_t domains[MAX_CELLS];
+	uint16_t region_colors[MAX_CELLS];
+
+	// A path stays in one region, entered from its head and left at
+	// its goal: start with the colors whose ends border the region
+	int connected = 0;
+	bitboard_t left = state->free;
+
+	while (bb_any_w(left, words)) {
+
+		bitboard_t region = bb_flood_w(bb_lowest_w(left, words), left,
+		                               words);
+		left = bb_andnot_w(left, region, words);
+
+		bitboard_t border = bb_dilate_w(region, words);
+		uint16_t colors = 0;
+
+		for (size_t color=0; color<info->num_colors; ++color) {
+			if ((live & (1 << color)) &&
+			    bb_test(&border, state->pos[color]) &&
+			    bb_test(&border, state->end[color])) {
+				colors |= 1 << color;
+			}
+		}
+
+		if (!colors) {
+			return DOMAINS_WIPEOUT;
+		}
+
+		connected |= colors;
+
+		for (int i=0; i<words; ++i) {
+			for (uint64_t bits=region.w[i]; bits; bits &= bits-1) {
+				pos_t pos = 64*i + __builtin_ctzll(bits);
+				domains[pos] = region_colors[pos] = colors;
+			}
+		}
+
+	}
+
+	if (live & ~done & ~connected) {
+		return DOMAINS_STRANDED;
+	}
+
+	// A path cannot go into a side of a cut cell and back out through
+	// it, so a side is only open to colors with an end on its border
+	cut_search(info, state, cs);
+
+	for (size_t i=0; i<cs->num_cuts; ++i) {
+
+		pos_t v = cs->cuts[i];
+		int num_sides = cs->num_cut_children[v];
+
+		if (num_sides == 1 && cs->low[v] == cs->pre[v]) {
+			continue;
+		}
+
+		uint16_t usable[5] = { 0, 0, 0, 0, 0 };
+
+		for (size_t color=0; color<info->num_colors; ++color) {
+
+			if (!(region_colors[v] & (1 << color))) {
+				continue;
+			}
+
+			uint64_t sides = cut_sides(cs, v, 2*color) |
+				cut_sides(cs, v, 2*color + 1);
+
+			for (int k=0; k<5; ++k) {
+				usable[k] |= ((sides >> k) & 1) << color;
+			}
+
+		}
+
+		for (int k=0; k<5; ++k) {
+			if ((k < num_sides || k == 4) && (region_colors[v] & ~usable[k])) {
+				narrow_side(cs, v, k, usable[k], domains);
+			}
+		}
+
+	}
+
+	// Any cell left without a color
+	for (int i=0; i<words; ++i) {
+		for (uint64_t bits=state->free.w[i]; bits; bits &= bits-1) {
+			if (!domains[64*i + __builtin_ctzll(bits)]) {
+				return DOMAINS_WIPEOUT;
+			}
+		}
+	}
+
+	// Pick the most constrained color next to a cell only it can take
+	size_t last_color = state->last_color;
+	state->next_color = MAX_COLORS;
+
+	if (last_color >= info->num_colors ||
+	    (state->completed & (1 << last_color))) {
+
+		int best_free = 5;
+
+		for (size_t i=0; i<info->num_colors; ++i) {
+
+			int color = info->color_order[i];
+
+			if (!(live & (1 << color))) {
+				continue;
+			}
+
+			int own = 0;
+
+			for (int dir=0; dir<4; ++dir) {
+				pos_t pos = info->neighbors[state->pos[color]][dir];
+				if (pos != INVALID_POS && bb_test(&state->free, pos) &&
+				    domains[pos] == (1 << color)) {
+					own = 1;
+				}
+			}
+
+			int num_free = __builtin_popcount((state->free_dirs >> (4*color))
+			                                  & 0xf);
+
+			if (own && num_free < best_free) {
+				best_free = num_free;
+				state->next_color = color;
+			}
+
+		}
+
+	}
+
+	return DOMAINS_OK;
+
+}
+
+#define DOMAINS_KERNEL(WORDS)                                           \
+	static int check_domains_##WORDS(const game_info_t* info,           \
+	                                 game_state_t* state,               \
+	                                 cut_search_t* cs) {                \
+		return check_domains(info, state, cs, WORDS);                   \
+	}
+
+DOMAINS_KERNEL(1)
+DOMAINS_KERNEL(2)
+DOMAINS_KERNEL(3)
+DOMAINS_KERNEL(4)
+
+//////////////////////////////////////////////////////////////////////
+// Work out, for each free cell, the colors that could still take it.
+// A path stays within one region of free cells, and cannot go into a
+// side of a cut cell and back out through it; cells only a single
+// color can take are given to it. Return DOMAINS_WIPEOUT if a cell is
+// left with no color, DOMAINS_STRANDED if a color is left no cells.
+// When the state has to pick a new color (the last one moved is
+// complete), a color next to a cell only it can take is stored as
+// next_color, so it moves next. On DOMAINS_OK, cs holds the cut
+// search of the state.
+
+int game_check_domains(const game_info_t* info, game_state_t* state,
+                       cut_search_t* cs) {
+
+	return check_domains(info, state, cs, BB_WORDS);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Domain check specialized for the board size of info
+
+domain_fn game_domains_kernel(const game_info_t* info) {
+
+	switch ((info->size + 3) / 4) {
+	case 1:  return check_domains_1;
+	case 2:  return check_domains_2;
+	case 3:  return check_domains_3;
+	default: return check_domains_4;
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Fold v into the running key h (splitmix64 finalizer)
+
+static inline uint64_t key_mix(uint64_t h, uint64_t v) {
+
+	h ^= v + 0x9e3779b97f4a7c15ULL;
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+
+	return h ^ (h >> 31);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Live colors with both head and goal next to region
+
+static int region_colors(const game_info_t* info, const game_state_t* state,
+                         bitboard_t region) {
+
+	bitboard_t border = bb_dilate(region);
+	int live = live_colors(info, state);
+	int colors = 0;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if ((live & (1 << color)) &&
+		    bb_test(&border, state->pos[color]) &&
+		    bb_test(&border, state->end[color])) {
+			colors |= 1 << color;
+		}
+	}
+
+	return colors;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Key of the sub-problem of filling region with colors: the region,
+// both ends of the colors and which cells around the region hold
+// them (a move may not run alongside its own path)
+
+static uint64_t region_key(const game_info_t* info, const game_state_t* state,
+                           bitboard_t region, int colors) {
+
+	uint64_t key = colors;
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		key = key_mix(key, region.w[i]);
+	}
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (colors & (1 << color)) {
+			key = key_mix(key, (color << 8) | state->pos[color]);
+			key = key_mix(key, (color << 8) | state->end[color]);
+		}
+	}
+
+	bitboard_t ring = bb_andnot(bb_and(bb_dilate(region), info->board),
+	                            region);
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		for (uint64_t bits=ring.w[i]; bits; bits &= bits-1) {
+			pos_t pos = 64*i + __builtin_ctzll(bits);
+			int color = cell_get_color(state->cells[pos]);
+			if (colors & (1 << color)) {
+				key = key_mix(key, (pos << 4) | color);
+			}
+		}
+	}
+
+	// Zero marks empty cache slots
+	return key ? key : 1;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Regions of state whose colors can use no other region, with their
+// keys; whether such a region can be filled depends on nothing else.
+// Return the number of regions stored.
+
+size_t game_exclusive_regions(const game_info_t* info,
+                              const game_state_t* state,
+                              region_t regions[MAX_COLORS]) {
+
+	bitboard_t cells[MAX_CELLS];
+	int colors[MAX_CELLS];
+	size_t num_cells = 0;
+
+	// Colors seen in a region, and those seen in more than one
+	int seen = 0, shared = 0;
+
+	bitboard_t left = state->free;
+
+	while (bb_any(left)) {
+
+		bitboard_t region = bb_flood_w(bb_lowest_w(left, BB_WORDS), left,
+		                               BB_WORDS);
+		left = bb_andnot(left, region);
+
+		int c = region_colors(info, state, region);
+		shared |= seen & c;
+		seen |= c;
+
+		cells[num_cells] = region;
+		colors[num_cells++] = c;
+
+	}
+
+	size_t num_regions = 0;
+
+	for (size_t r=0; r<num_cells; ++r) {
+		if (colors[r] && !(colors[r] & shared)) {
+			region_t* region = regions + num_regions++;
+			region->cells = cells[r];
+			region->colors = colors[r];
+			region->size = bb_count(cells[r]);
+			region->key = region_key(info, state, cells[r], colors[r]);
+		}
+	}
+
+	return num_regions;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Depth-first search of a state holding a single region, spending at
+// most *budget nodes; the solution goes to solved, if given
+
+static int solve_region(const game_info_t* info, const game_state_t* state,
+                        int* budget, game_state_t* solved) {
+
+	if (state->completed == (1 << info->num_colors) - 1) {
+		if (state->num_free) {
+			return REGION_DEAD;
+		}
+		if (solved) {
+			*solved = *state;
+		}
+		return REGION_SOLVABLE;
+	}
+
+	if (--*budget < 0) {
+		return REGION_UNKNOWN;
+	}
+
+	game_state_t from = *state;
+	int color = game_next_move_color(info, &from);
+
+	if (game_pick_end(info, &from, color)) {
+		game_swap_ends(info, &from, color, NULL);
+	}
+
+	int legal_dirs = game_legal_dirs(info, &from, color);
+
+	for (int dir=0; dir<4; ++dir) {
+
+		if (!(legal_dirs & (1 << dir))) {
+			continue;
+		}
+
+		game_state_t child = from;
+		game_make_move(info, &child, color, dir);
+
+		if (game_apply_forced(info, &child, NULL) < 0 ||
+		    game_check_patterns(info, &child) ||
+		    game_check_regions(info, &child) != REGIONS_OK) {
+			continue;
+		}
+
+		int result = solve_region(info, &child, budget, solved);
+		if (result != REGION_DEAD) {
+			return result;
+		}
+
+	}
+
+	return REGION_DEAD;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Try to fill region with its colors alone, by a depth-first search of
+// at most max_nodes nodes. The other free cells are filled and the
+// other colors marked complete, which only takes away moves that
+// would strand a color outside its region.
+
+int game_solve_region(const game_info_t* info, const game_state_t* state,
+                      const region_t* region, int max_nodes,
+                      game_state_t* solved) {
+
+	int all = (1 << info->num_colors) - 1;
+
+	// Filler must not run alongside a path of the region's colors
+	if (region->colors == all) {
+		return REGION_UNKNOWN;
+	}
+
+	int filler = __builtin_ctz(all & ~region->colors);
+
+	game_state_t sub = *state;
+	bitboard_t other = bb_andnot(state->free, region->cells);
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		for (uint64_t bits=other.w[i]; bits; bits &= bits-1) {
+			sub.cells[64*i + __builtin_ctzll(bits)] =
+				cell_create(TYPE_PATH, filler, 0);
+		}
+	}
+
+	sub.free = region->cells;
+	sub.num_free = region->size;
+	sub.completed |= all & ~region->colors;
+	memset(&sub.dirty, 0, sizeof(sub.dirty));
+
+	game_update_free_dirs(info, &sub);
+	game_update_open(info, &sub);
+
+	return solve_region(info, &sub, &max_nodes, solved);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Copy the paths that fill region in solved into state
+
+void game_merge_region(const game_info_t* info, game_state_t* state,
+                       const region_t* region, const game_state_t* solved) {
+
+	for (int i=0; i<BB_WORDS; ++i) {
+		for (uint64_t bits=region->cells.w[i]; bits; bits &= bits-1) {
+			pos_t pos = 64*i + __builtin_ctzll(bits);
+			state->cells[pos] = solved->cells[pos];
+		}
+	}
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (region->colors & (1 << color)) {
+			// An end that never moved took the direction the path
+			// came in from (see game_make_move)
+			pos_t head = solved->pos[color], end = solved->end[color];
+			state->cells[head] = solved->cells[head];
+			state->cells[end] = solved->cells[end];
+			state->pos[color] = head;
+			state->end[color] = end;
+		}
+	}
+
+	state->free = bb_andnot(state->free, region->cells);
+	state->num_free -= region->size;
+	state->completed |= region->colors;
+
+	game_update_free_dirs(info, state);
+	game_update_open(info, state);
+	state->hash = game_hash_state(info, state);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Scores of game_priority, one per PRIORITY_ value; lower is better
+
+static int score_cost(const game_info_t* info, const game_state_t* state) {
+	// Every cell but the endpoints starts free
+	return bb_count(info->board) - 2*(int)info->num_colors - state->num_free;
+}
+
+static int score_completed(const game_info_t* info,
+                           const game_state_t* state) {
+	return __builtin_popcount(live_colors(info, state));
+}
+
+static int score_regions(const game_info_t* info, const game_state_t* state) {
+
+	int regions = 0;
+	bitboard_t left = state->free;
+
+	while (bb_any(left)) {
+		left = bb_andnot(left, bb_flood_w(bb_lowest_w(left, BB_WORDS), left,
+		                                  BB_WORDS));
+		++regions;
+	}
+
+	return regions;
+
+}
+
+static int score_distance(const game_info_t* info,
+                          const game_state_t* state) {
+
+	int distance = 0;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (!(state->completed & (1 << color))) {
+			int head = state->pos[color], goal = state->end[color];
+			distance += abs((head & 0xf) - (goal & 0xf)) +
+				abs((head >> 4) - (goal >> 4));
+		}
+	}
+
+	return distance;
+
+}
+
+static int score_slack(const game_info_t* info, const game_state_t* state) {
+
+	int slack = 4;
+
+	for (size_t color=0; color<info->num_colors; ++color) {
+		if (!(state->completed & (1 << color))) {
+			int dirs = __builtin_popcount((state->free_dirs >> (4*color)) & 0xf);
+			if (dirs < slack) { slack = dirs; }
+		}
+	}
+
+	return slack;
+
+}
+
+static int (* const PRIORITY_SCORES[NUM_PRIORITIES])(const game_info_t*,
+                                                     const game_state_t*) = {
+	score_cost, score_completed, score_regions, score_distance, score_slack
+};
+
+//////////////////////////////////////////////////////////////////////
+// Weighted sum of the scores of state (see PRIORITY_ in options.h),
+// at most UINT16_MAX so it fits a node's priority
+
+int game_priority(const game_info_t* info, const game_state_t* state,
+                  const int weights[NUM_PRIORITIES]) {
+
+	int64_t priority = 0;
+
+	for (int k=0; k<NUM_PRIORITIES; ++k) {
+		if (weights[k]) {
+			priority += (int64_t)weights[k] * PRIORITY_SCORES[k](info, state);
+		}
+	}
+
+	return priority < UINT16_MAX ? (int)priority : UINT16_MAX;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Store the legal directions of color in order, best first: by the
+// weighted features of the cell each moves to (see ORDER_ in
+// options.h), then by direction. Without weights the order is that of
+// the directions. Return the number of directions.
+
+int game_order_moves(const game_info_t* info, const game_state_t* state,
+                     int color, int legal_dirs, const int* weights,
+                     uint8_t order[4]) {
+
+	int num_moves = 0;
+	int score[4];
+
+	pos_t head = state->pos[color];
+	pos_t goal = state->end[color];
+
+	for (int dir=0; dir<4; ++dir) {
+
+		if (!(legal_dirs & (1 << dir))) {
+			continue;
+		}
+
+		int s = 0;
+
+		if (weights) {
+
+			pos_t pos = info->neighbors[head][dir];
+
+			s = weights[ORDER_GOAL] * (abs((pos & 0xf) - (goal & 0xf)) +
+			                           abs((pos >> 4) - (goal >> 4))) +
+				weights[ORDER_WALL] * info->wall_dist[pos] +
+				weights[ORDER_DEGREE] * game_num_free_pos(info, state, pos);
+
+		}
+
+		// Insertion sort; equal scores keep the direction order
+		int i = num_moves++;
+
+		while (i > 0 && score[i-1] > s) {
+			score[i] = score[i-1];
+			order[i] = order[i-1];
+			--i;
+		}
+
+		score[i] = s;
+		order[i] = dir;
+
+	}
+
+	return num_moves;
+
+}
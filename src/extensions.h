@@ -4,6 +4,7 @@
 
 #include "utils.h"
 #include "node.h"
+#include "options.h"
 
 //////////////////////////////////////////////////////////////////////
 // Place the game colors into a set order
@@ -18,9 +19,177 @@ int color_features_compare(const void* vptr_a, const void* vptr_b);
 // put an active path into and out of it. Any freespace node which
 // has only one free neighbor represents such a dead end. For the
 // purposes of this check, cur and goal positions count as "free".
+// Only the cells the last move marked dirty are tested.
 
 int game_check_deadends(const game_info_t* info, const game_state_t* state);
 
+// Signature of game_check_deadends and its specialized variants
+typedef int (*deadend_fn)(const game_info_t* info, const game_state_t* state);
+
+//////////////////////////////////////////////////////////////////////
+// Dead-end check specialized for the board size of info
+
+deadend_fn game_deadend_kernel(const game_info_t* info);
+
+//////////////////////////////////////////////////////////////////////
+// Look up every domino (two adjacent cells and their six other
+// neighbors) that touches a dirty cell in the table of dead patterns
+// made by gen_patterns.c: free cells with too few ways in and out, or
+// short corridors that would join two heads or two goals. Return 1
+// if one of them is dead.
+
+int game_check_patterns(const game_info_t* info, const game_state_t* state);
+
+// Outcome of game_check_regions
+enum {
+	REGIONS_OK = 0,       // Every region and color can still be served
+	REGIONS_ISOLATED = 1, // A free region no live color can fill
+	REGIONS_STRANDED = 2, // A color whose head and goal share no region
+};
+
+//////////////////////////////////////////////////////////////////////
+// Split free space into connected regions. Every region must border
+// both the head and the goal of some live color (a path that enters
+// it can only leave at its own goal), and every live color must have
+// its head and goal on the border of a common region.
+
+int game_check_regions(const game_info_t* info, const game_state_t* state);
+
+//////////////////////////////////////////////////////////////////////
+// Region check specialized for the board size of info
+
+deadend_fn game_regions_kernel(const game_info_t* info);
+
+// Low-link numbering of the free cells, filled in by the domain and
+// cut checks
+typedef struct cut_search_struct {
+	uint8_t pre[MAX_CELLS];   // Preorder number (1-based, 0 unvisited)
+	uint8_t low[MAX_CELLS];   // Lowest preorder reachable from subtree
+	uint8_t last[MAX_CELLS];  // Highest preorder within subtree
+	uint8_t tree[MAX_CELLS];  // Search tree (free region) of the cell
+	// Children whose subtree only reaches the rest through the cell
+	pos_t   cut_child[MAX_CELLS][4];
+	uint8_t num_cut_children[MAX_CELLS];
+	pos_t   cuts[MAX_CELLS];  // Cells with at least one such child
+	size_t  num_cuts;
+	pos_t   order[MAX_CELLS+1]; // Cell of each preorder number
+	uint8_t tree_first[MAX_CELLS]; // Preorder numbers of each tree
+	uint8_t tree_last[MAX_CELLS];
+	// Preorder numbers of the free neighbors of each color's head
+	// (2*color) and goal (2*color+1)
+	uint8_t end_pre[2*MAX_COLORS][4];
+	uint8_t num_end_pre[2*MAX_COLORS];
+} cut_search_t;
+
+// Outcome of game_check_domains
+enum {
+	DOMAINS_OK = 0,       // Every free cell has a color that can take it
+	DOMAINS_WIPEOUT = 1,  // A free cell no color can take any more
+	DOMAINS_STRANDED = 2, // A color with no cell left between its ends
+};
+
+// Signature of game_check_domains and its specialized variants
+typedef int (*domain_fn)(const game_info_t* info, game_state_t* state,
+                         cut_search_t* cs);
+
+//////////////////////////////////////////////////////////////////////
+// Work out, for each free cell, the colors that could still take it.
+// A path stays within one region of free cells, and cannot go into a
+// side of a cut cell and back out through it; cells only a single
+// color can take are given to it. Return DOMAINS_WIPEOUT if a cell is
+// left with no color, DOMAINS_STRANDED if a color is left no cells.
+// When the state has to pick a new color (the last one moved is
+// complete), a color next to a cell only it can take is stored as
+// next_color, so it moves next. On DOMAINS_OK, cs holds the cut
+// search of the state, for game_check_cuts.
+
+int game_check_domains(const game_info_t* info, game_state_t* state,
+                       cut_search_t* cs);
+
+//////////////////////////////////////////////////////////////////////
+// Domain check specialized for the board size of info
+
+domain_fn game_domains_kernel(const game_info_t* info);
+
+//////////////////////////////////////////////////////////////////////
+// Find the cut cells of the free-cell graph (articulation points, by
+// Tarjan's low-link numbering). Only one path fits through a single
+// cell, so the state is hopeless if two live colors have their head
+// and goal on different sides of the same cut cell. Return 1 then.
+// done is the cut search game_check_domains made of state, or NULL.
+
+int game_check_cuts(const game_info_t* info, const game_state_t* state,
+                    const cut_search_t* done);
+
+//////////////////////////////////////////////////////////////////////
+// Apply forced moves until none is left: a live color whose head (or
+// with -b, other end) has a single legal direction has to take it,
+// since its legal moves can only shrink. Return the number of moves
+// applied, or -1 if a live color has no legal move left. The dirty
+// cells of state cover all the moves applied and the one before them.
+// The moves go into log, if not NULL.
+
+int game_apply_forced(const game_info_t* info, game_state_t* state,
+                      game_undo_log_t* log);
+
+// A region of free cells whose colors can use no other region
+typedef struct region_struct {
+	bitboard_t cells; // Free cells of the region
+	int colors;       // Live colors with head and goal next to it
+	int size;         // Number of cells
+	uint64_t key;     // Cells, colors, heads and the colors' path cells
+	                  // around it; equal keys, equal outcome
+} region_t;
+
+// Outcome of game_solve_region
+enum {
+	REGION_SOLVABLE = 0, // The colors can fill the region
+	REGION_DEAD = 1,     // They cannot, so no state holding it is solvable
+	REGION_UNKNOWN = 2,  // Search gave up
+};
+
+//////////////////////////////////////////////////////////////////////
+// Split free space into connected regions and keep the ones that no
+// other region shares a color with (a path that enters a region can
+// only leave at its own goal). Whether such a region can be filled
+// depends only on what its key covers. Return the number kept.
+
+size_t game_exclusive_regions(const game_info_t* info,
+                              const game_state_t* state,
+                              region_t regions[MAX_COLORS]);
+
+//////////////////////////////////////////////////////////////////////
+// Search, depth first and for at most max_nodes nodes, for a way to
+// fill region (from game_exclusive_regions on state) with its colors.
+// If there is one and solved is given, store the filled state there.
+
+int game_solve_region(const game_info_t* info, const game_state_t* state,
+                      const region_t* region, int max_nodes,
+                      game_state_t* solved);
+
+//////////////////////////////////////////////////////////////////////
+// Copy the paths that fill region in solved (see game_solve_region)
+// into state, completing its colors
+
+void game_merge_region(const game_info_t* info, game_state_t* state,
+                       const region_t* region, const game_state_t* solved);
+
+//////////////////////////////////////////////////////////////////////
+// Weighted sum of the scores of state (see PRIORITY_ in options.h)
+
+int game_priority(const game_info_t* info, const game_state_t* state,
+                  const int weights[NUM_PRIORITIES]);
+
+//////////////////////////////////////////////////////////////////////
+// Store the legal directions of color in order, best first: by the
+// weighted features of the cell each moves to (see ORDER_ in
+// options.h), then by direction. Without weights the order is that of
+// the directions. Return the number of directions.
+
+int game_order_moves(const game_info_t* info, const game_state_t* state,
+                     int color, int legal_dirs, const int* weights,
+                     uint8_t order[4]);
+
 
 
 #endif
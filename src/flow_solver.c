@@ -12,6 +12,21 @@
 #include "search.h"
 
 
+//////////////////////////////////////////////////////////////////////
+// Verbose name of a search result. The depth-first engines store no
+// nodes, so for them running out means the -n/-m budget of states was
+// spent, not memory.
+
+static const char* result_string(int result) {
+
+	if (result == SEARCH_FULL && g_options.search_engine != ENGINE_DIJKSTRA) {
+		return "out of budget";
+	}
+
+	return SEARCH_RESULT_STRINGS[result];
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Main function
 
@@ -27,10 +42,35 @@ int main(int argc, char** argv) {
 	g_options.display_save_svg = 0;
   
 	g_options.node_check_deadends = 0;
+	g_options.node_check_patterns = 0;
+	g_options.node_check_regions = 0;
+	g_options.node_check_cuts = 0;
+	g_options.node_forced = 0;
+	g_options.node_domains = 0;
+	g_options.node_nogoods = 0;
+	g_options.node_split = 0;
+	g_options.node_transpositions = 0;
+	g_options.node_reclaim = 0;
+	g_options.node_deferred = 0;
 	g_options.order_most_constrained = 1;
+	g_options.order_both_ends = 0;
+	memset(g_options.order_moves, 0, sizeof(g_options.order_moves));
+	g_options.order_moves_on = 0;
 
 	g_options.search_max_nodes = 0;
 	g_options.search_max_mb = 1024;
+	g_options.search_engine = ENGINE_DIJKSTRA;
+	g_options.search_frontier = FRONTIER_HEAP;
+	memset(g_options.search_priority, 0, sizeof(g_options.search_priority));
+	g_options.search_priority[PRIORITY_COST] = 1;
+	g_options.search_scored = 0;
+	g_options.search_priority_spec = "cost";
+	g_options.search_queue_timing = 0;
+	g_options.search_huge_pages = 0;
+	g_options.search_auto_storage = 0;
+	g_options.search_generic = 0;
+	g_options.search_threads = 0;
+	g_options.display_memory = 0;
 
 	const char* input_files[argc];
 
@@ -76,6 +116,7 @@ int main(int argc, char** argv) {
 
 			double elapsed;
 			size_t nodes;
+			search_stats_t stats;
 			game_state_t final_state = state;
 
 			if (g_options.display_quiet) { 
@@ -84,8 +125,15 @@ int main(int argc, char** argv) {
 			}
 
 
-			int result = game_dijkstra_search(&info, &state, &elapsed, &nodes, 
-            &final_state);
+			int result;
+
+			if (g_options.search_engine != ENGINE_DIJKSTRA) {
+				result = game_dfs_search(&info, &state, &elapsed, &nodes,
+				                         &stats, &final_state);
+			} else {
+				result = game_dijkstra_search(&info, &state, &elapsed, &nodes, 
+            &stats, &final_state);
+			}
 			
 
 			// If search is still in progress, then throw error
@@ -98,19 +146,31 @@ int main(int argc, char** argv) {
 			if (!g_options.display_quiet) {
   
 
-				double q_mb = (nodes * (double)sizeof(tree_node_t) / MEGABYTE);
+				printf("\nsearch %s after %'.3f seconds and %'zu nodes",
+				       result_string(result), elapsed, nodes);
+
+				// Only Dijkstra keeps its nodes; with -D, nodes counts
+				// the moves queued, and only the arena nodes take room
+				if (g_options.search_engine == ENGINE_DIJKSTRA) {
+					size_t kept = g_options.node_deferred ? stats.stored : nodes;
+					double q_mb = (kept * (double)node_size(&info) / MEGABYTE);
+					printf(" (%'.2f MB)", q_mb);
+				}
+
+				printf("\n");
 
-				printf("\nsearch %s after %'.3f seconds and %'zu nodes (%'.2f MB)\n",
-				       SEARCH_RESULT_STRINGS[result],
-				       elapsed,
-				       nodes, q_mb);
+				if (search_stats_print(&stats, "search stats:")) {
+					printf("\n");
+				}
 
 
 			}
 			else {
-				printf("%c %'12.3f %'12zu\n",
+				printf("%c %'12.3f %'12zu",
 				       SEARCH_RESULT_CHARS[result],
 				       elapsed, nodes);
+				search_stats_print(&stats, "");
+				printf("\n");
 				
 			}
 
@@ -163,7 +223,7 @@ int main(int argc, char** argv) {
 			for (int i=0; i<3; ++i) {
 				if (total_count[i]) {
 					printf("%'d %s searches took a total of %'.3f seconds and %'zu nodes\n",
-					       total_count[i], SEARCH_RESULT_STRINGS[i],
+					       total_count[i], result_string(i),
 					       total_elapsed[i], total_nodes[i]);
 				}
 			}
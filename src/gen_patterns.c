@@ -0,0 +1,174 @@
+/**
+ * Generator for src/patterns.h, the table of dead domino patterns
+ * used by game_check_patterns (see extensions.h). Run "make patterns"
+ * after changing the rules below.
+ *
+ * A pattern is two adjacent cells x and y plus their six other
+ * neighbors, each one of the CELL_ classes below. The eight cells are
+ * laid out as
+ *
+ *     .  s1x s1y  .
+ *     ex  x   y  ey
+ *     .  s2x s2y  .
+ *
+ * and packed two bits each, in the order x, y, s1x, s1y, s2x, s2y, ex,
+ * ey, from the low bits up. The same table serves dominoes in any
+ * orientation, since the rules do not tell the two sides apart.
+ *
+ * Every neighbor of x and y is in the window, so paths must give x
+ * and y their exact number of path edges: two for a free cell, one
+ * for a head or goal (open endpoint) and none for a blocked cell. The
+ * ring cells may have at most one edge into the domino (a free ring
+ * cell may continue outside). A pattern is dead when no choice of
+ * edges does that without a path that links two heads or two goals,
+ * which always belong to different colors.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+enum {
+	CELL_BLOCKED = 0, // Wall, off the board, or a closed path cell
+	CELL_FREE = 1,
+	CELL_HEAD = 2,    // Head of a color not completed
+	CELL_GOAL = 3,    // Goal of a color not completed
+};
+
+enum {
+	NUM_CELLS = 8,
+	NUM_EDGES = 7,
+	NUM_PATTERNS = 1 << (2*NUM_CELLS)
+};
+
+// Cell numbers in pattern order
+enum { X, Y, S1X, S1Y, S2X, S2Y, EX, EY };
+
+// The adjacencies of the window that touch x or y
+static const int EDGES[NUM_EDGES][2] = {
+	{ X, Y },
+	{ X, S1X }, { X, S2X }, { X, EX },
+	{ Y, S1Y }, { Y, S2Y }, { Y, EY },
+};
+
+//////////////////////////////////////////////////////////////////////
+// Is the pattern fillable with the given edge subset?
+
+static int edges_fit(const int* cls, int edges) {
+
+	int degree[NUM_CELLS] = { 0 };
+	int other[NUM_CELLS][2];
+
+	for (int e=0; e<NUM_EDGES; ++e) {
+		if (edges & (1 << e)) {
+			int a = EDGES[e][0], b = EDGES[e][1];
+			if (cls[a] == CELL_BLOCKED || cls[b] == CELL_BLOCKED) {
+				return 0;
+			}
+			other[a][degree[a]++ & 1] = b;
+			other[b][degree[b]++ & 1] = a;
+		}
+	}
+
+	// x and y have all their neighbors here
+	for (int c=X; c<=Y; ++c) {
+		int need = cls[c] == CELL_FREE ? 2 : cls[c] == CELL_BLOCKED ? 0 : 1;
+		if (degree[c] != need) {
+			return 0;
+		}
+	}
+
+	// Ring cells only touch one of x and y, so at most one edge
+	for (int c=S1X; c<NUM_CELLS; ++c) {
+		if (degree[c] > 1) {
+			return 0;
+		}
+	}
+
+	// Follow the path from every endpoint; it must not end at an
+	// endpoint of the same kind
+	for (int start=0; start<NUM_CELLS; ++start) {
+
+		if ((cls[start] != CELL_HEAD && cls[start] != CELL_GOAL) ||
+		    degree[start] != 1) {
+			continue;
+		}
+
+		int prev = start, cur = other[start][0];
+
+		while (cls[cur] == CELL_FREE && degree[cur] == 2) {
+			int next = other[cur][0] == prev ? other[cur][1] : other[cur][0];
+			prev = cur;
+			cur = next;
+		}
+
+		if (cls[cur] == cls[start] && degree[cur] == 1) {
+			return 0;
+		}
+
+	}
+
+	return 1;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Main function
+
+int main(int argc, char** argv) {
+
+	FILE* fp = argc > 1 ? fopen(argv[1], "w") : stdout;
+
+	if (!fp) {
+		fprintf(stderr, "can't write %s\n", argv[1]);
+		exit(1);
+	}
+
+	static uint64_t dead[NUM_PATTERNS / 64];
+	int num_dead = 0;
+
+	for (int index=0; index<NUM_PATTERNS; ++index) {
+
+		int cls[NUM_CELLS];
+
+		for (int c=0; c<NUM_CELLS; ++c) {
+			cls[c] = (index >> (2*c)) & 3;
+		}
+
+		int fits = 0;
+
+		for (int edges=0; edges<(1 << NUM_EDGES) && !fits; ++edges) {
+			fits = edges_fit(cls, edges);
+		}
+
+		if (!fits) {
+			dead[index / 64] |= (uint64_t)1 << (index % 64);
+			++num_dead;
+		}
+
+	}
+
+	fprintf(fp,
+	        "// Generated by src/gen_patterns.c (make patterns), do not edit.\n"
+	        "// Dead domino patterns: bit i is set if pattern i can never be\n"
+	        "// filled; %d of %d patterns are dead.\n\n"
+	        "#ifndef __PATTERNS__\n"
+	        "#define __PATTERNS__\n\n"
+	        "#include <stdint.h>\n\n"
+	        "static const uint64_t PATTERN_DEAD[%d] = {\n",
+	        num_dead, NUM_PATTERNS, NUM_PATTERNS / 64);
+
+	for (int i=0; i<NUM_PATTERNS / 64; ++i) {
+		fprintf(fp, "%s0x%016llxULL,%s", i % 3 ? " " : "\t",
+		        (unsigned long long)dead[i], i % 3 == 2 ? "\n" : "");
+	}
+
+	fprintf(fp, "%s};\n\n#endif\n", (NUM_PATTERNS / 64) % 3 ? "\n" : "");
+
+	if (fp != stdout) {
+		fclose(fp);
+	}
+
+	return 0;
+
+}
@@ -4,15 +4,147 @@
 #include "node.h"
 #include "engine.h"
 #include "extensions.h"
+#include "options.h"
+
+// Cold payload of a node: the Zobrist hash, then the cells of the
+// board packed row by row (positions use a row stride of 16, the
+// payload uses info->size), then with -b the other end of each color
+// (without it the ends never move). Only read through memcpy, so
+// unaligned.
+#define NODE_COLD_HASH   0
+#define NODE_COLD_CELLS  sizeof(uint64_t)
+
+//////////////////////////////////////////////////////////////////////
+// Offset of the other ends in the cold payload
+
+static size_t node_cold_ends(const game_info_t* info) {
+	return NODE_COLD_CELLS + info->size * info->size;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Offset of the color the domain check picked, after the ends
+
+static size_t node_cold_next(const game_info_t* info) {
+	return node_cold_ends(info) +
+		(g_options.order_both_ends ? info->num_colors : 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bytes of cold payload per node of this puzzle
+
+static size_t node_cold_size(const game_info_t* info) {
+	return node_cold_next(info) + (g_options.node_domains ? 1 : 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bytes taken by one node of this puzzle
+
+size_t node_size(const game_info_t* info) {
+	return sizeof(tree_node_t) + node_cold_size(info);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Copy the rows of a board between the packed node layout and a state,
+// rebuilding the free bitboard on the way in (same as game_update_free,
+// without a second pass over the cells). Written once and instantiated
+// per board size below, so each copy sees a constant size and can
+// unroll its row and cell loops.
+
+KERNEL_INLINE void pack_rows(uint8_t* cells, const game_state_t* state,
+                             const size_t size) {
+
+	for (size_t y=0; y<size; ++y) {
+		memcpy(cells + y*size, state->cells + (y << 4), size);
+	}
+
+}
+
+KERNEL_INLINE void unpack_rows(const uint8_t* cells, game_state_t* out,
+                               const size_t size) {
+
+	memset(&out->free, 0, sizeof(out->free));
+
+	for (size_t y=0; y<size; ++y) {
+
+		const uint8_t* row = cells + y*size;
+		memcpy(out->cells + (y << 4), row, size);
+
+		uint64_t free_row = 0;
+		for (size_t x=0; x<size; ++x) {
+			free_row |= (uint64_t)(row[x] == 0) << x;
+		}
+		out->free.w[y >> 2] |= free_row << ((y & 3) << 4);
+
+	}
+
+}
+
+#define NODE_ROWS_KERNEL(SIZE)                                          \
+	static void pack_rows_##SIZE(uint8_t* cells,                        \
+	                             const game_state_t* state, size_t size) { \
+		(void)size;                                                     \
+		pack_rows(cells, state, SIZE);                                  \
+	}                                                                   \
+	static void unpack_rows_##SIZE(const uint8_t* cells,                \
+	                               game_state_t* out, size_t size) {    \
+		(void)size;                                                     \
+		unpack_rows(cells, out, SIZE);                                  \
+	}
+
+NODE_ROWS_KERNEL(5)
+NODE_ROWS_KERNEL(6)
+NODE_ROWS_KERNEL(7)
+NODE_ROWS_KERNEL(8)
+NODE_ROWS_KERNEL(9)
+NODE_ROWS_KERNEL(10)
+NODE_ROWS_KERNEL(11)
+NODE_ROWS_KERNEL(12)
+NODE_ROWS_KERNEL(13)
+NODE_ROWS_KERNEL(14)
+NODE_ROWS_KERNEL(15)
+
+static void pack_rows_generic(uint8_t* cells, const game_state_t* state,
+                              size_t size) {
+	pack_rows(cells, state, size);
+}
+
+static void unpack_rows_generic(const uint8_t* cells, game_state_t* out,
+                                size_t size) {
+	unpack_rows(cells, out, size);
+}
+
+#define NODE_ROWS_ENTRY(SIZE) [SIZE] = { pack_rows_##SIZE, unpack_rows_##SIZE }
+
+// Row kernels by board size; smaller boards use the generic pair
+static const struct {
+	void (*pack)(uint8_t*, const game_state_t*, size_t);
+	void (*unpack)(const uint8_t*, game_state_t*, size_t);
+} node_rows_kernels[MAX_SIZE+1] = {
+	NODE_ROWS_ENTRY(5),  NODE_ROWS_ENTRY(6),  NODE_ROWS_ENTRY(7),
+	NODE_ROWS_ENTRY(8),  NODE_ROWS_ENTRY(9),  NODE_ROWS_ENTRY(10),
+	NODE_ROWS_ENTRY(11), NODE_ROWS_ENTRY(12), NODE_ROWS_ENTRY(13),
+	NODE_ROWS_ENTRY(14), NODE_ROWS_ENTRY(15),
+};
 
 //////////////////////////////////////////////////////////////////////
-// Compare total cost for nodes, used by heap functions below.
+// Cold payload of the given node
+
+static uint8_t* node_cold(const node_memory_t* storage,
+                          const tree_node_t* node) {
+	return storage->cold + (size_t)(node - storage->start) *
+		storage->cold_stride;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Compare priorities for nodes, used by heap functions below. Ties
+// go to the lower node address, which is creation order unless -R
+// has reused a freed slot.
 
 int node_compare(const tree_node_t* a,
                  const tree_node_t* b) {
 
-	double af = a->cost_to_node;
-	double bf = b->cost_to_node;
+	int af = a->priority;
+	int bf = b->priority;
 
 	if (af != bf) {
 		return af < bf ? -1 : 1;
@@ -23,7 +155,43 @@ int node_compare(const tree_node_t* a,
 }
 
 //////////////////////////////////////////////////////////////////////
-// Create a node and set the cost to the node
+// Cost to node
+
+int node_cost(const tree_node_t* node) {
+	return node->cost_to_node;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Priority of node on the frontier (lower first)
+
+int node_priority(const tree_node_t* node) {
+	return node->priority;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Node at the given index
+
+tree_node_t* node_at(const node_memory_t* storage, uint32_t index) {
+	return storage->start + index;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Index of the given node
+
+uint32_t node_index(const node_memory_t* storage, const tree_node_t* node) {
+	return node - storage->start;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Parent of the given node (NULL for root)
+
+tree_node_t* node_parent(const node_memory_t* storage,
+                         const tree_node_t* node) {
+	return node->parent == NODE_NONE ? NULL : node_at(storage, node->parent);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Create a node holding state and set the cost to the node
 
 tree_node_t* node_create(node_memory_t* storage, tree_node_t* parent,
                          const game_state_t* state) {
@@ -33,62 +201,217 @@ tree_node_t* node_create(node_memory_t* storage, tree_node_t* parent,
 	
 	if (!new_n) { return 0; }
 
-	new_n->parent = parent;
+	new_n->parent = NODE_NONE;
 	new_n->cost_to_node = 0;
+	new_n->num_children = 0;
 
-	// update cost to node, unless is the root
-	const size_t action_cost = 1;
-	if (parent)
+	// update cost to node, unless is the root; every move fills one
+	// cell, and a child may hold several moves (see game_apply_forced)
+	if (parent) {
+		size_t action_cost = parent->num_free - state->num_free;
+		new_n->parent = node_index(storage, parent);
 		new_n->cost_to_node = parent->cost_to_node + action_cost;
-	
-	memcpy(&(new_n->state), state, sizeof(game_state_t));
+		++parent->num_children;
+	}
+
+	new_n->priority = new_n->cost_to_node;
+
+	if (g_options.search_scored) {
+		new_n->priority = game_priority(storage->info, state,
+		                                g_options.search_priority);
+	}
+
+	new_n->num_free = state->num_free;
+	new_n->last_color = state->last_color;
+	new_n->completed = state->completed;
+	memcpy(new_n->pos, state->pos, sizeof(new_n->pos));
+
+	// Pack the board for this board size
+	uint8_t* payload = node_cold(storage, new_n);
+	memcpy(payload + NODE_COLD_HASH, &state->hash, sizeof(uint64_t));
+
+	storage->pack_rows(payload + NODE_COLD_CELLS, state, storage->size);
+
+	if (g_options.order_both_ends) {
+		memcpy(payload + node_cold_ends(storage->info), state->end,
+		       storage->info->num_colors);
+	}
+
+	if (g_options.node_domains) {
+		payload[node_cold_next(storage->info)] = state->next_color;
+	}
   
 	return new_n;
 
 }
 
+//////////////////////////////////////////////////////////////////////
+// Unpack the state of a node into out, which must already hold a
+// state of the same puzzle (cells off the board are left untouched)
+
+void node_get_state(const node_memory_t* storage, const tree_node_t* node,
+                    game_state_t* out) {
+
+	out->num_free = node->num_free;
+	out->last_color = node->last_color;
+	out->completed = node->completed;
+	memcpy(out->pos, node->pos, sizeof(node->pos));
+
+	const uint8_t* payload = node_cold(storage, node);
+	memcpy(&out->hash, payload + NODE_COLD_HASH, sizeof(uint64_t));
+
+	storage->unpack_rows(payload + NODE_COLD_CELLS, out, storage->size);
+
+	if (g_options.order_both_ends) {
+		memcpy(out->end, payload + node_cold_ends(storage->info),
+		       storage->info->num_colors);
+	}
+
+	out->next_color = g_options.node_domains ?
+		payload[node_cold_next(storage->info)] : MAX_COLORS;
+
+	game_update_free_dirs(storage->info, out);
+	game_update_open(storage->info, out);
+
+	// A stored state already passed the dead-end check
+	memset(&out->dirty, 0, sizeof(out->dirty));
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Allocate sufficient memory space for a new node
 
 tree_node_t* node_mem_alloc(node_memory_t* storage) {
 
-	// 	Ensure that there is enough memory to allocate for the new node
-  	if (storage->count >= storage->capacity) {
-    	return NULL;
-  	}
+	tree_node_t* new_n;
+
+	if (storage->free_list != NODE_NONE) {
+
+		// Reuse the most recently released node
+		new_n = node_at(storage, storage->free_list);
+		storage->free_list = new_n->parent;
+
+	} else {
 
-	// Allocate memory space to new_node 
-	tree_node_t* new_n = storage->start + storage->count;
-	++storage->count;
+		// 	Ensure that there is enough memory to allocate for the new node
+		if (storage->count >= storage->capacity ||
+		    !arena_commit(&storage->arena,
+		                  (storage->count+1)*sizeof(tree_node_t)) ||
+		    !arena_commit(&storage->cold_arena,
+		                  (storage->count+1)*storage->cold_stride)) {
+			return NULL;
+		}
+
+		// Allocate memory space to new_node 
+		new_n = node_at(storage, storage->count);
+		++storage->count;
+
+	}
+
+	if (++storage->live > storage->peak_live) {
+		storage->peak_live = storage->live;
+	}
 
 	return new_n;
 }
 
 //////////////////////////////////////////////////////////////////////
-// Linearly allocate memory spcace for search nodes
+// Return a node to the free list and drop its reference on its parent
+
+void node_mem_free(node_memory_t* storage, tree_node_t* node) {
+
+	assert(!node->num_children);
+
+	tree_node_t* parent = node_parent(storage, node);
+	if (parent) {
+		assert(parent->num_children);
+		--parent->num_children;
+	}
+
+	node->parent = storage->free_list;
+	storage->free_list = node_index(storage, node);
 
-node_memory_t create_node_mem(size_t max_nodes) {
+	--storage->live;
+	++storage->freed;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Release an expanded node whose children are all gone, and every
+// ancestor left without children as a result; return # released
+
+size_t node_release_dead(node_memory_t* storage, tree_node_t* node) {
+
+	size_t released = 0;
+
+	while (node && !node->num_children) {
+		tree_node_t* parent = node_parent(storage, node);
+		node_mem_free(storage, node);
+		node = parent;
+		++released;
+	}
+
+	return released;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reserve space for up to max_nodes search nodes, committed on demand
+
+node_memory_t create_node_mem(const game_info_t* info, size_t max_nodes) {
 
     node_memory_t storage;
 
-    // Allocate memory space to the first node
-    storage.start = malloc(max_nodes*sizeof(tree_node_t));
+    // Node indices are 32 bits, NODE_NONE excluded
+    if (max_nodes >= NODE_NONE) {
+        max_nodes = NODE_NONE - 1;
+    }
+
+    storage.cold_stride = node_cold_size(info);
+    storage.info = info;
+    storage.size = info->size;
 
-    // If there is no memory available to allocate
-    if (!storage.start) {
-    fprintf(stderr, "unable to allocate memory for node storage!\n");
-    exit(1);
+    // Row kernels specialized for this board size, if there is one
+    storage.pack_rows = pack_rows_generic;
+    storage.unpack_rows = unpack_rows_generic;
+    if (!g_options.search_generic && node_rows_kernels[info->size].pack) {
+        storage.pack_rows = node_rows_kernels[info->size].pack;
+        storage.unpack_rows = node_rows_kernels[info->size].unpack;
     }
 
+    // Reserve address space only; pages are committed by node_mem_alloc
+    storage.arena = arena_reserve(max_nodes*sizeof(tree_node_t),
+                                  g_options.search_huge_pages);
+    storage.start = (tree_node_t*)storage.arena.start;
+
+    storage.cold_arena = arena_reserve(max_nodes*storage.cold_stride,
+                                       g_options.search_huge_pages);
+    storage.cold = storage.cold_arena.start;
+
     //Define maximum number of nodes that can be allocated memory
     storage.capacity = max_nodes;
     //Initialise number of nodes already used
     storage.count = 0;
+    storage.live = storage.peak_live = storage.freed = 0;
+    storage.free_list = NODE_NONE;
 
     return storage;
     
 }
 
+//////////////////////////////////////////////////////////////////////
+// Release the memory space of all search nodes
+
+void destroy_node_mem(node_memory_t* storage) {
+
+    arena_release(&storage->arena);
+    arena_release(&storage->cold_arena);
+    storage->start = NULL;
+    storage->cold = NULL;
+    storage->capacity = storage->count = 0;
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Perform diagnostics on the given node
 
@@ -98,12 +421,12 @@ void node_diagnostics(const game_info_t* info,
 	printf("\n###################################"
 	       "###################################\n\n");
 
-	printf("node has cost to node %'g and cost to go %'d\n",
-	       node->cost_to_node, node->state.num_free);
+	printf("node has cost to node %'d and cost to go %'d\n",
+	       node_cost(node), node->num_free);
 
-	if (node->state.last_color < info->num_colors) {
+	if (node->last_color < info->num_colors) {
 		printf("last move was for color %s\n",
-		       color_name_str(info, node->state.last_color));
+		       color_name_str(info, node->last_color));
 
 	} else {
 		printf("no moves yet?\n");
@@ -112,20 +435,95 @@ void node_diagnostics(const game_info_t* info,
 }
 
 //////////////////////////////////////////////////////////////////////
-// Animate the solution by printing out boards in reverse order,
-// following parent pointers back from solution to root.
+// Print one board of the animation
 
-void animate_solution(const game_info_t* info,
-                           const tree_node_t* node) {
-
-	if (node->parent) {
-		animate_solution(info, node->parent);
-	}
+static void animate_board(const game_info_t* info,
+                          const game_state_t* state) {
 
 	printf("%s", unprint_board(info));
-	game_print(info, &node->state);
+	game_print(info, state);
 	fflush(stdout);
 
 	delay_seconds(0.1);
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Replay the moves that lead from the state in scratch (the parent's)
+// to the one of node, printing a board after each. A node made of
+// several forced moves shows every one of them: the path of each color
+// is followed cell by cell from the parent's ends, since each path
+// cell records the direction it was entered from.
+
+static void animate_moves(const game_info_t* info,
+                          const node_memory_t* storage,
+                          const tree_node_t* node,
+                          game_state_t* scratch) {
+
+	game_state_t target = *scratch;
+	node_get_state(storage, node, &target);
+
+	int moved = 1;
+
+	while (moved) {
+
+		moved = 0;
+
+		for (size_t color=0; color<info->num_colors; ++color) {
+
+			// With -b either end may have grown; an end that is one
+			// of the target's ends is done
+			int grown = 0;
+
+			for (int e=0; e<2 && !grown; ++e) {
+
+				pos_t from = e ? scratch->end[color] : scratch->pos[color];
+
+				if (from == target.pos[color] || from == target.end[color]) {
+					continue;
+				}
+
+				for (int dir=0; dir<4; ++dir) {
+
+					pos_t next = info->neighbors[from][dir];
+
+					if (next != INVALID_POS && bb_test(&scratch->free, next) &&
+					    target.cells[next] == cell_create(TYPE_PATH, color, dir)) {
+						if (e) {
+							game_swap_ends(info, scratch, color, NULL);
+						}
+						game_make_move(info, scratch, color, dir);
+						animate_board(info, scratch);
+						grown = moved = 1;
+						break;
+					}
+
+				}
+
+			}
+
+		}
+
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Animate the solution by printing out boards in reverse order,
+// following parent pointers back from solution to root.
+
+void animate_solution(const game_info_t* info,
+                      const node_memory_t* storage,
+                      const tree_node_t* node,
+                      game_state_t* scratch) {
+
+	const tree_node_t* parent = node_parent(storage, node);
+	if (parent) {
+		animate_solution(info, storage, parent, scratch);
+		animate_moves(info, storage, node, scratch);
+	} else {
+		node_get_state(storage, node, scratch);
+		animate_board(info, scratch);
+	}
   
 }
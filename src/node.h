@@ -6,39 +6,98 @@
 
 #include "utils.h"
 #include "engine.h"
+#include "arena.h"
 
 
 /**
  * Data structure containing the node information
  */
 
+// Index value meaning "no node"
+#define NODE_NONE UINT32_MAX
 
-// Search node for DIJKSTRA
+// Search node for DIJKSTRA: the hot part of a node, 32 bytes, holding
+// what the queues, color selection and reclamation look at. The board
+// (hash and cells) lives in a parallel cold array indexed by the same
+// node id, packed for the puzzle at hand; node_get_state / node_create
+// below read and write both.
 typedef struct tree_node_struct {
-	game_state_t state;              // Current game state
-	double cost_to_node;             // Cost to node
-	struct tree_node_struct* parent; // Parent of this node (may be NULL)
+	uint32_t parent;        // Index of parent node (NODE_NONE for root),
+	                        // next free node once released
+	uint32_t num_children;  // Children still holding this node
+	uint16_t cost_to_node;  // Cost to node
+	uint16_t priority;      // Frontier key: cost_to_node, or the -P scores
+	uint8_t  num_free;      // Free cells left in the state
+	uint8_t  last_color;    // Last color moved in the state
+	uint16_t completed;     // Completed colors in the state
+	pos_t    pos[MAX_COLORS]; // Head position of each color
 } tree_node_t;
 
 typedef struct node_storage_struct {
-  tree_node_t* start; 
-  size_t capacity;    
-  size_t count;       
+  tree_node_t* start; // Hot array: first node of the reserved arena
+  uint8_t* cold;      // Cold array: board of each node, same index
+  size_t cold_stride; // Bytes per board for this puzzle
+  const game_info_t* info; // Puzzle the layout was made for
+  size_t size;        // Board size of that puzzle
+  size_t capacity;    // Hard cap on the number of nodes
+  size_t count;       // Nodes handed out so far (high-water mark)
+  size_t live;        // Nodes handed out and not released
+  size_t peak_live;   // Highest value of live
+  size_t freed;       // Nodes released over the whole search
+  uint32_t free_list; // Released nodes, reused first
+  arena_t arena;      // Address space of the hot array
+  // Copy board rows to/from the cold array, picked for the board size
+  void (*pack_rows)(uint8_t* cells, const game_state_t* state, size_t size);
+  void (*unpack_rows)(const uint8_t* cells, game_state_t* out, size_t size);
+  arena_t cold_arena; // Address space of the cold array
 } node_memory_t;
 
-// Compare total cost for nodes, used by heap functions below.
+// Bytes taken by one node of this puzzle
+size_t node_size(const game_info_t* info);
+
+// Compare priorities for nodes, used by heap functions below.
 int node_compare(const tree_node_t* a, const tree_node_t* b);
 
-// Create Node and update cost
+// Cost to node
+int node_cost(const tree_node_t* node);
+
+// Priority of node on the frontier (lower first)
+int node_priority(const tree_node_t* node);
+
+// Node at the given index
+tree_node_t* node_at(const node_memory_t* storage, uint32_t index);
+
+// Index of the given node
+uint32_t node_index(const node_memory_t* storage, const tree_node_t* node);
+
+// Parent of the given node (NULL for root)
+tree_node_t* node_parent(const node_memory_t* storage, const tree_node_t* node);
+
+// Create Node holding state and update cost
 tree_node_t* node_create(node_memory_t* storage, tree_node_t* parent, 
 						const game_state_t* state);
 
-// Linearly allocate memory space for search nodes
-node_memory_t create_node_mem(size_t max_nodes);
+// Unpack the state of a node into out, which must already hold a
+// state of the same puzzle (cells off the board are left untouched)
+void node_get_state(const node_memory_t* storage, const tree_node_t* node,
+                    game_state_t* out);
+
+// Reserve space for up to max_nodes search nodes, committed on demand
+node_memory_t create_node_mem(const game_info_t* info, size_t max_nodes);
+
+// Release the memory space of all search nodes
+void destroy_node_mem(node_memory_t* storage);
 
 // Allocate sufficient memory space for a new node
 tree_node_t* node_mem_alloc(node_memory_t* storage);
 
+// Return a node to the free list and drop its reference on its parent
+void node_mem_free(node_memory_t* storage, tree_node_t* node);
+
+// Release an expanded node whose children are all gone, and every
+// ancestor left without children as a result; return # released
+size_t node_release_dead(node_memory_t* storage, tree_node_t* node);
+
 
 //////////////////////////////////////////////////////////////////////
 // Perform diagnostics on the given node
@@ -50,7 +109,8 @@ void node_diagnostics(const game_info_t* info, const tree_node_t* node);
 // Animate the solution by printing out boards in reverse order,
 // following parent pointers back from solution to root.
 
-void animate_solution(const game_info_t* info, const tree_node_t* node);
+void animate_solution(const game_info_t* info, const node_memory_t* storage,
+                      const tree_node_t* node, game_state_t* scratch);
 
 
 
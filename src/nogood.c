@@ -0,0 +1,102 @@
+#include "nogood.h"
+
+//////////////////////////////////////////////////////////////////////
+// First slot of the bucket of key
+
+static size_t nogood_bucket(const nogood_cache_t* c, uint64_t key) {
+	return ((key ^ (key >> 32)) & (c->num_buckets - 1)) * NOGOOD_WAYS;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Create a cache of max_entries keys (rounded up to a power of 2)
+
+nogood_cache_t nogood_create(size_t max_entries) {
+
+	nogood_cache_t c;
+
+	c.num_buckets = 1;
+	while (c.num_buckets * NOGOOD_WAYS < max_entries) {
+		c.num_buckets *= 2;
+	}
+
+	size_t slots = c.num_buckets * NOGOOD_WAYS;
+
+	c.keys = calloc(slots, sizeof(uint64_t));
+	c.outcome = calloc(slots, sizeof(uint8_t));
+	c.used = calloc(slots, sizeof(uint32_t));
+
+	if (!c.keys || !c.outcome || !c.used) {
+		fprintf(stderr, "out of memory creating nogood cache!\n");
+		exit(1);
+	}
+
+	c.tick = 0;
+	c.hits = c.misses = c.stored = c.evicted = 0;
+
+	return c;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Look up the outcome stored for key (NOGOOD_ABSENT if none); counts
+// a hit or a miss
+
+int nogood_lookup(nogood_cache_t* c, uint64_t key) {
+
+	size_t first = nogood_bucket(c, key);
+
+	for (size_t i=first; i<first+NOGOOD_WAYS; ++i) {
+		if (c->keys[i] == key) {
+			c->used[i] = ++c->tick;
+			++c->hits;
+			return c->outcome[i];
+		}
+	}
+
+	++c->misses;
+
+	return NOGOOD_ABSENT;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Store the outcome for key (nonzero), evicting the least recently
+// used key of its bucket if needed
+
+void nogood_insert(nogood_cache_t* c, uint64_t key, int outcome) {
+
+	size_t first = nogood_bucket(c, key);
+	size_t victim = first;
+
+	for (size_t i=first; i<first+NOGOOD_WAYS; ++i) {
+
+		if (c->keys[i] == key) {
+			c->outcome[i] = outcome;
+			c->used[i] = ++c->tick;
+			return;
+		}
+
+		// Empty slots have never been used, so they go first
+		if (c->used[i] < c->used[victim]) {
+			victim = i;
+		}
+
+	}
+
+	c->evicted += c->keys[victim] != 0;
+	++c->stored;
+
+	c->keys[victim] = key;
+	c->outcome[victim] = outcome;
+	c->used[victim] = ++c->tick;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for cache
+
+void nogood_destroy(nogood_cache_t* c) {
+	free(c->keys);
+	free(c->outcome);
+	free(c->used);
+}
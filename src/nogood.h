@@ -0,0 +1,58 @@
+#ifndef __NOGOOD__
+#define __NOGOOD__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+enum {
+	NOGOOD_WAYS = 4,           // Slots per bucket
+	NOGOOD_ENTRIES = 1 << 18,  // Default number of slots
+	NOGOOD_MAX_CELLS = 24,     // Largest region searched for a verdict
+	NOGOOD_MAX_NODES = 4096,   // Node budget of that search
+};
+
+// Result of nogood_lookup for a key not cached
+enum {
+	NOGOOD_ABSENT = -1
+};
+
+// Bounded map from keys of sub-problems (free regions, see
+// game_exclusive_regions) to the outcome of searching them (one of
+// the REGION_ values). Keys hash to a bucket of NOGOOD_WAYS slots; a
+// full bucket evicts its least recently used key.
+typedef struct nogood_cache_struct {
+	uint64_t* keys;     // Slots, 0 marks an empty slot
+	uint8_t* outcome;   // Outcome stored with each key
+	uint32_t* used;     // Tick of the last insert or hit of each slot
+	size_t num_buckets; // Number of buckets (power of 2)
+	uint32_t tick;      // Bumped on every insert and hit
+	size_t hits;        // Lookups that found their key
+	size_t misses;      // Lookups that did not
+	size_t stored;      // Keys inserted
+	size_t evicted;     // Keys pushed out by them
+} nogood_cache_t;
+
+//////////////////////////////////////////////////////////////////////
+// Create a cache of max_entries keys (rounded up to a power of 2)
+
+nogood_cache_t nogood_create(size_t max_entries);
+
+//////////////////////////////////////////////////////////////////////
+// Look up the outcome stored for key (NOGOOD_ABSENT if none); counts
+// a hit or a miss
+
+int nogood_lookup(nogood_cache_t* c, uint64_t key);
+
+//////////////////////////////////////////////////////////////////////
+// Store the outcome for key (nonzero), evicting the least recently
+// used key of its bucket if needed
+
+void nogood_insert(nogood_cache_t* c, uint64_t key, int outcome);
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for cache
+
+void nogood_destroy(nogood_cache_t* c);
+
+#endif
@@ -4,6 +4,16 @@
 // Global options struct gets setup during main
 options_t g_options;
 
+// Names of the move features on the command line, in ORDER_ order
+const char* ORDER_NAMES[NUM_ORDER_FEATURES] = {
+	"goal", "wall", "degree"
+};
+
+// Names of the scores on the command line, in PRIORITY_ order
+const char* PRIORITY_NAMES[NUM_PRIORITIES] = {
+	"cost", "completed", "regions", "distance", "slack"
+};
+
 //////////////////////////////////////////////////////////////////////
 // Command line usage
 
@@ -24,14 +34,58 @@ void usage(FILE* fp, int exitcode) {
 		"\n"
 		"Node evaluation options:\n\n"
 		"  -d, --deadends          dead-end checking\n"
+		"  -p, --patterns          Prune dead 2-cell patterns from a generated\n"
+		"                          table (includes the -d dead ends)\n"
+		"  -g, --regions           Prune free regions no color can fill and\n"
+		"                          colors cut off from their goal\n"
+		"  -k, --cuts              Prune states where two colors must cross\n"
+		"                          the same single-cell bottleneck\n"
+		"  -f, --forced            Apply forced moves within a child instead\n"
+		"                          of making a node for each\n"
+		"  -o, --domains           Track the colors each free cell can take;\n"
+		"                          prune empty domains, move owners first;\n"
+		"                          implies -g\n"
+		"  -N, --nogoods           Search small free regions on their own, cache\n"
+		"                          the ones that fail and prune states holding one\n"
+		"  -s, --split             Search regions that share no color on their\n"
+		"                          own; finish the puzzle once all are filled\n"
+		"  -t, --transpositions    Drop duplicate states via Zobrist hashing\n"
+		"  -R, --reclaim           Reuse memory of fully dead subtrees\n"
+		"  -D, --deferred          Queue (parent, move) and build children when\n"
+		"                          popped (uses heap4 unless -Q bucket*;\n"
+		"                          off with a -P other than cost)\n"
 		"\n"
 		"Color ordering options:\n\n"
 		"  -r, --randomize         Shuffle order of colors before solving\n"
 		"  -c, --constrained       Disable order by most constrained\n"
+		"  -b, --bidirectional     Grow each path from either end, whichever\n"
+		"                          has fewer legal moves\n"
+		"  -O, --order-moves SPEC  Try moves by a sum of features NAME[:WEIGHT],...\n"
+		"                          from goal, wall and degree (of the cell\n"
+		"                          moved to), lowest first; none keeps the\n"
+		"                          direction order. Reports first=.\n"
 		"\n"
 		"Search options:\n\n"
+		"  -e, --engine KIND       Search: dijkstra (default), dfs (depth first\n"
+		"                          on one state; -n/-m cap its nodes) or lds\n"
+		"                          (dfs allowing 0, 1, 2... discrepancies)\n"
 		"  -n, --max-nodes N       Restrict storage to N nodes\n"
 		"  -m, --max-storage N     Restrict storage to N MB (default %'g)\n"
+		"  -Q, --queue KIND        Frontier: heap (default), heap4, bucket,\n"
+		"                          bucket-lifo\n"
+		"  -P, --priority SPEC     Node priority for dijkstra, a sum of scores\n"
+		"                          NAME[:WEIGHT],... from cost (default),\n"
+		"                          completed, regions, distance and slack;\n"
+		"                          lowest first, ties by node index (not\n"
+		"                          insertion order with -R/-D); weights 0 to 64\n"
+		"  -T, --queue-timing      Report frontier enqueue/dequeue throughput\n"
+		"  -a, --auto-storage      Size storage from available system memory\n"
+		"  -H, --huge-pages        Back node storage with transparent huge pages\n"
+		"  -M, --memory-stats      Report startup latency and peak RSS\n"
+		"  -G, --generic           Use generic kernels, not the ones specialized\n"
+		"                          for the board size and pruning options\n"
+		"  -j, --threads           Search the regions of a split (-s) on\n"
+		"                          separate threads\n"
 		"\n"
 		"Help:\n\n"
 		"  -h, --help              See this help text\n\n",
@@ -75,6 +129,58 @@ int exists(const char* fn) {
 }
 
 
+//////////////////////////////////////////////////////////////////////
+// Parse a spec of NAME[:WEIGHT] terms separated by commas, NAME one
+// of the count names given, into weights; return 0 if it is malformed
+// or a name's weight adds up to more than MAX_WEIGHT
+
+int parse_weights(const char* spec, const char** names, int count,
+                  int* weights) {
+
+	const char* c = spec;
+
+	memset(weights, 0, count*sizeof(int));
+
+	while (1) {
+
+		size_t len = strcspn(c, ":,");
+		int k = count;
+
+		while (k-- > 0 &&
+		       (strlen(names[k]) != len || strncmp(c, names[k], len))) { }
+
+		if (k < 0) {
+			return 0;
+		}
+
+		c += len;
+		long weight = 1;
+
+		if (*c == ':') {
+			char* endptr;
+			weight = strtol(c+1, &endptr, 10);
+			if (endptr == c+1 || weight < 0 || weight > MAX_WEIGHT) {
+				return 0;
+			}
+			c = endptr;
+		}
+
+		weights[k] += weight;
+
+		if (weights[k] > MAX_WEIGHT) {
+			return 0;
+		}
+
+		if (!*c) {
+			return 1;
+		} else if (*c++ != ',') {
+			return 0;
+		}
+
+	}
+
+}
+
 //////////////////////////////////////////////////////////////////////
 // Parse command-line options
 
@@ -105,10 +211,31 @@ size_t parse_options(int argc, char** argv,
 		{ 'F', "fast",          &g_options.display_fast, 1 },
 		{ 'S', "svg",           &g_options.display_save_svg, 1 },
 		{ 'd', "deadends",      &g_options.node_check_deadends, 1 },
+		{ 'p', "patterns",      &g_options.node_check_patterns, 1 },
+		{ 'g', "regions",       &g_options.node_check_regions, 1 },
+		{ 'k', "cuts",          &g_options.node_check_cuts, 1 },
+		{ 'f', "forced",        &g_options.node_forced, 1 },
+		{ 'o', "domains",       &g_options.node_domains, 1 },
+		{ 'N', "nogoods",       &g_options.node_nogoods, 1 },
+		{ 's', "split",         &g_options.node_split, 1 },
+		{ 't', "transpositions", &g_options.node_transpositions, 1 },
+		{ 'R', "reclaim",       &g_options.node_reclaim, 1 },
+		{ 'D', "deferred",      &g_options.node_deferred, 1 },
 		{ 'r', "randomize",     &g_options.order_random, 1 },
 		{ 'c', "constrained",   &g_options.order_most_constrained, 0 },
+		{ 'b', "bidirectional", &g_options.order_both_ends, 1 },
 		{ 'n', "max-nodes",     0, 0 },
 		{ 'm', "max-storage",   0, 0 },
+		{ 'e', "engine",        0, 0 },
+		{ 'Q', "queue",         0, 0 },
+		{ 'P', "priority",      0, 0 },
+		{ 'O', "order-moves",   0, 0 },
+		{ 'T', "queue-timing",  &g_options.search_queue_timing, 1 },
+		{ 'a', "auto-storage",  &g_options.search_auto_storage, 1 },
+		{ 'H', "huge-pages",    &g_options.search_huge_pages, 1 },
+		{ 'M', "memory-stats",  &g_options.display_memory, 1 },
+		{ 'G', "generic",       &g_options.search_generic, 1 },
+		{ 'j', "threads",       &g_options.search_threads, 1 },
 		{ 'h', "help",          0, 0 },
 		{ 0, 0, 0, 0 }
 	};
@@ -174,6 +301,74 @@ size_t parse_options(int argc, char** argv,
 					exit(1);
 				}
         
+			} else if (match_short_char == 'e') {
+
+				opt = get_argument(argc, argv, &i);
+
+				if (!strcmp(opt, "dijkstra")) {
+					g_options.search_engine = ENGINE_DIJKSTRA;
+				} else if (!strcmp(opt, "dfs")) {
+					g_options.search_engine = ENGINE_DFS;
+				} else if (!strcmp(opt, "lds")) {
+					g_options.search_engine = ENGINE_LDS;
+				} else {
+					fprintf(stderr, "error parsing search engine %s "
+						"on command line!\n\n", opt);
+					exit(1);
+				}
+
+			} else if (match_short_char == 'Q') {
+
+				opt = get_argument(argc, argv, &i);
+
+				if (!strcmp(opt, "heap")) {
+					g_options.search_frontier = FRONTIER_HEAP;
+				} else if (!strcmp(opt, "heap4")) {
+					g_options.search_frontier = FRONTIER_HEAP4;
+				} else if (!strcmp(opt, "bucket")) {
+					g_options.search_frontier = FRONTIER_BUCKET_FIFO;
+				} else if (!strcmp(opt, "bucket-lifo")) {
+					g_options.search_frontier = FRONTIER_BUCKET_LIFO;
+				} else {
+					fprintf(stderr, "error parsing queue kind %s "
+						"on command line!\n\n", opt);
+					exit(1);
+				}
+
+			} else if (match_short_char == 'P') {
+
+				opt = get_argument(argc, argv, &i);
+
+				if (!parse_weights(opt, PRIORITY_NAMES, NUM_PRIORITIES,
+				                   g_options.search_priority)) {
+					fprintf(stderr, "error parsing priority %s "
+						"on command line!\n\n", opt);
+					exit(1);
+				}
+
+				// Cost alone is the plain Dijkstra order
+				g_options.search_scored = 0;
+				for (int k=0; k<NUM_PRIORITIES; ++k) {
+					g_options.search_scored |=
+						g_options.search_priority[k] != (k == PRIORITY_COST);
+				}
+
+				g_options.search_priority_spec = opt;
+
+			} else if (match_short_char == 'O') {
+
+				opt = get_argument(argc, argv, &i);
+
+				if (strcmp(opt, "none") &&
+				    !parse_weights(opt, ORDER_NAMES, NUM_ORDER_FEATURES,
+				                   g_options.order_moves)) {
+					fprintf(stderr, "error parsing move order %s "
+						"on command line!\n\n", opt);
+					exit(1);
+				}
+
+				g_options.order_moves_on = 1;
+
 			} else if (match_short_char == 'h') {
 
 				usage(stdout, 0);
@@ -203,6 +398,18 @@ size_t parse_options(int argc, char** argv,
 		exit(1);
 	}
 
+	// The domain check starts with the region tests of -g
+	if (g_options.node_domains) {
+		g_options.node_check_regions = 0;
+	}
+
+	// A deferred entry is keyed before its child exists, by the parent's
+	// priority plus one; only cost grows that way, so scored -P builds
+	// children at once
+	if (g_options.search_scored) {
+		g_options.node_deferred = 0;
+	}
+
 	return num_inputs;
 
 }
@@ -4,6 +4,50 @@
 #include <stdio.h>
 #include <stdint.h>
 
+// Priority queue used as search frontier
+enum {
+	FRONTIER_HEAP = 0,        // Binary heap of node pointers
+	FRONTIER_BUCKET_FIFO = 1, // One FIFO bucket per integer cost
+	FRONTIER_BUCKET_LIFO = 2, // One LIFO bucket per integer cost
+	FRONTIER_HEAP4 = 3,       // 4-ary heap with inline integer keys
+};
+
+// Search engine
+enum {
+	ENGINE_DIJKSTRA = 0,      // Best first over stored nodes
+	ENGINE_DFS = 1,           // Depth first on one state, with undo
+	ENGINE_LDS = 2,           // DFS allowing 0, 1, 2... discrepancies
+};
+
+// Scores a node priority is built from (-P); lower is expanded first
+enum {
+	PRIORITY_COST = 0,       // Cells filled so far, as Dijkstra
+	PRIORITY_COMPLETED = 1,  // Colors not completed yet
+	PRIORITY_REGIONS = 2,    // Connected regions of free cells
+	PRIORITY_DISTANCE = 3,   // Head-to-goal Manhattan distances, summed
+	PRIORITY_SLACK = 4,      // Free directions of the tightest head
+	NUM_PRIORITIES = 5
+};
+
+// Names of the scores on the command line, in the order above
+extern const char* PRIORITY_NAMES[NUM_PRIORITIES];
+
+// Largest weight of a -P or -O term. The -P scores of a board are at
+// most 239 cells, 16 colors, 239 regions, 16*30 distance and 4 slack,
+// so even every weight at 64 keeps the sum in a 16-bit node priority.
+#define MAX_WEIGHT 64
+
+// Features a color's moves are ranked by (-O); lower is tried first
+enum {
+	ORDER_GOAL = 0,          // Manhattan distance from the cell to the goal
+	ORDER_WALL = 1,          // Distance from the cell to the nearest wall
+	ORDER_DEGREE = 2,        // Free neighbors of the cell
+	NUM_ORDER_FEATURES = 3
+};
+
+// Names of the features on the command line, in the order above
+extern const char* ORDER_NAMES[NUM_ORDER_FEATURES];
+
 // Options for this program
 typedef struct options_struct {
 
@@ -15,12 +59,36 @@ typedef struct options_struct {
 	int    display_save_svg;  
 
 	int    node_check_deadends;
+	int    node_check_patterns;
+	int    node_check_regions;
+	int    node_check_cuts;
+	int    node_forced;
+	int    node_domains;
+	int    node_nogoods;
+	int    node_split;
+	int    node_transpositions;
+	int    node_reclaim;
+	int    node_deferred;
   
 	int    order_most_constrained;
 	int    order_random;
+	int    order_both_ends;   // Set by -b, grow paths from either end
+	int    order_moves[NUM_ORDER_FEATURES]; // Weight of each feature
+	int    order_moves_on;    // Set by -O, ranks and counts first moves
 
 	size_t search_max_nodes;
 	double search_max_mb;
+	int    search_engine;
+	int    search_frontier;
+	int    search_priority[NUM_PRIORITIES]; // Weight of each score
+	int    search_scored;     // Set unless the weights are cost alone
+	const char* search_priority_spec;
+	int    search_queue_timing;
+	int    search_huge_pages;
+	int    search_auto_storage;
+	int    search_generic;
+	int    search_threads;
+	int    display_memory;
   
 } options_t;
 
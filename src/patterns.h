@@ -0,0 +1,355 @@
+// Generated by src/gen_patterns.c (make patterns), do not edit.
+// Dead domino patterns: bit i is set if pattern i can never be
+// filled; 8545 of 65536 patterns are dead.
+
+#ifndef __PATTERNS__
+#define __PATTERNS__
+
+#include <stdint.h>
+
+static const uint64_t PATTERN_DEAD[1024] = {
+	0xb5fa97f695f2b7feULL, 0xa01a06160012a63eULL, 0xa55a07760552a77eULL,
+	0xb0ba96969092b6beULL, 0x95f095f095f095f2ULL, 0x0010001000100012ULL,
+	0x0550055005500552ULL, 0x9090909090909092ULL, 0x95f097f695f097f6ULL,
+	0x0010061600100616ULL, 0x0550077605500776ULL, 0x9090969690909696ULL,
+	0xb5fa95f095f0b5faULL, 0xa01a00100010a01aULL, 0xa55a05500550a55aULL,
+	0xb0ba90909090b0baULL, 0xa01a06160012a63eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0x0010001000100012ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0010061600100616ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa55a07760552a77eULL,
+	0xa00a06060002a62eULL, 0xa55a07760552a77eULL, 0xa00a06060002a62eULL,
+	0x0550055005500552ULL, 0x0000000000000002ULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550077605500776ULL, 0x0000060600000606ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xb0ba96969092b6beULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xb0ba96969092b6beULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0x95f095f095f095f2ULL, 0x0010001000100012ULL,
+	0x0550055005500552ULL, 0x9090909090909092ULL, 0x95f095f095f095f0ULL,
+	0x0010001000100010ULL, 0x0550055005500550ULL, 0x9090909090909090ULL,
+	0x95f095f095f095f0ULL, 0x0010001000100010ULL, 0x0550055005500550ULL,
+	0x9090909090909090ULL, 0x95f095f095f095f0ULL, 0x0010001000100010ULL,
+	0x0550055005500550ULL, 0x9090909090909090ULL, 0x0010001000100012ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0010001000100010ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0010001000100010ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0550055005500552ULL, 0x0000000000000002ULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x95f097f695f097f6ULL,
+	0x0010061600100616ULL, 0x0550077605500776ULL, 0x9090969690909696ULL,
+	0x95f095f095f095f0ULL, 0x0010001000100010ULL, 0x0550055005500550ULL,
+	0x9090909090909090ULL, 0x95f097f695f097f6ULL, 0x0010061600100616ULL,
+	0x0550077605500776ULL, 0x9090969690909696ULL, 0x95f095f095f095f0ULL,
+	0x0010001000100010ULL, 0x0550055005500550ULL, 0x9090909090909090ULL,
+	0x0010061600100616ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0010001000100010ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0010061600100616ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0550077605500776ULL, 0x0000060600000606ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550077605500776ULL,
+	0x0000060600000606ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090969690909696ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x9090969690909696ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0xb5fa95f095f0b5faULL, 0xa01a00100010a01aULL, 0xa55a05500550a55aULL,
+	0xb0ba90909090b0baULL, 0x95f095f095f095f0ULL, 0x0010001000100010ULL,
+	0x0550055005500550ULL, 0x9090909090909090ULL, 0x95f095f095f095f0ULL,
+	0x0010001000100010ULL, 0x0550055005500550ULL, 0x9090909090909090ULL,
+	0xb5fa95f095f0b5faULL, 0xa01a00100010a01aULL, 0xa55a05500550a55aULL,
+	0xb0ba90909090b0baULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0x0010001000100010ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0xa01a06160012a63eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0x0010001000100012ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0010061600100616ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0x0010001000100012ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0010001000100010ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0010001000100010ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0010061600100616ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0010001000100010ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0010061600100616ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0x0010001000100010ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0010001000100010ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0xa01a00100010a01aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa55a07760552a77eULL,
+	0xa00a06060002a62eULL, 0xa55a07760552a77eULL, 0xa00a06060002a62eULL,
+	0x0550055005500552ULL, 0x0000000000000002ULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550077605500776ULL, 0x0000060600000606ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa55a07760552a77eULL, 0xa00a06060002a62eULL,
+	0xa55a07760552a77eULL, 0xa00a06060002a62eULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550055005500552ULL, 0x0000000000000002ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550077605500776ULL,
+	0x0000060600000606ULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xa55a05500550a55aULL, 0xa00a00000000a00aULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0x0550055005500552ULL, 0x0000000000000002ULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0550055005500552ULL,
+	0x0000000000000002ULL, 0x0550055005500552ULL, 0x0000000000000002ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0550077605500776ULL, 0x0000060600000606ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550077605500776ULL,
+	0x0000060600000606ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0550077605500776ULL, 0x0000060600000606ULL, 0x0550077605500776ULL,
+	0x0000060600000606ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550077605500776ULL,
+	0x0000060600000606ULL, 0x0550077605500776ULL, 0x0000060600000606ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0xa55a05500550a55aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xa55a05500550a55aULL, 0xa00a00000000a00aULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0x0550055005500550ULL, 0x0000000000000000ULL,
+	0x0550055005500550ULL, 0x0000000000000000ULL, 0x0550055005500550ULL,
+	0x0000000000000000ULL, 0xa55a05500550a55aULL, 0xa00a00000000a00aULL,
+	0xa55a05500550a55aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba96969092b6beULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xb0ba96969092b6beULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a06060002a62eULL,
+	0xa00a06060002a62eULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba96969092b6beULL, 0xa00a06060002a62eULL, 0xa00a06060002a62eULL,
+	0xb0ba96969092b6beULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000002ULL, 0x0000000000000002ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909092ULL, 0x0000000000000002ULL,
+	0x0000000000000002ULL, 0x9090909090909092ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090969690909696ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x9090969690909696ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090969690909696ULL,
+	0x0000060600000606ULL, 0x0000060600000606ULL, 0x9090969690909696ULL,
+	0x9090909090909090ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x9090909090909090ULL, 0x9090969690909696ULL, 0x0000060600000606ULL,
+	0x0000060600000606ULL, 0x9090969690909696ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0xa00a00000000a00aULL,
+	0xa00a00000000a00aULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL, 0x9090909090909090ULL, 0x0000000000000000ULL,
+	0x0000000000000000ULL, 0x9090909090909090ULL, 0x9090909090909090ULL,
+	0x0000000000000000ULL, 0x0000000000000000ULL, 0x9090909090909090ULL,
+	0xb0ba90909090b0baULL, 0xa00a00000000a00aULL, 0xa00a00000000a00aULL,
+	0xb0ba90909090b0baULL,
+};
+
+#endif
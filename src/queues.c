@@ -1,15 +1,14 @@
 #include "queues.h"
+#include "utils.h"
 
 //////////////////////////////////////////////////////////////////////
 // Create a binary heap to store the given # of nodes
 
 heapq_t heapq_create(size_t max_nodes) {
 	heapq_t heapq;
-	heapq.start = malloc(sizeof(tree_node_t*) * max_nodes);
-	if (!heapq.start) {
-		fprintf(stderr, "out of memory creating heapq!\n");
-		exit(1);
-	}
+	heapq.arena = arena_reserve(sizeof(tree_node_t*) * max_nodes,
+	                            g_options.search_huge_pages);
+	heapq.start = (tree_node_t**)heapq.arena.start;
 	heapq.count = 0;
 	heapq.total_count=0;
 	heapq.capacity = max_nodes;
@@ -67,6 +66,11 @@ void heapq_enqueue(heapq_t* q, tree_node_t* node) {
 
 	assert(q->count < q->capacity);
 
+	if (!arena_commit(&q->arena, (q->count+1) * sizeof(tree_node_t*))) {
+		fprintf(stderr, "out of memory growing heapq!\n");
+		exit(1);
+	}
+
 	size_t i = q->count++;
 	q->total_count++;
 	size_t pi = HEAPQ_PARENT_INDEX(i);
@@ -134,7 +138,491 @@ tree_node_t* heapq_deque(heapq_t* q) {
 // Free memory allocated for heap
 
 void heapq_destroy(heapq_t* q) {
-	free(q->start);
+	arena_release(&q->arena);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Indexing macros for 4-ary heaps
+
+#define HEAPQ4_ARITY 4
+#define HEAPQ4_PARENT_INDEX(i) (((i)-1)/HEAPQ4_ARITY)
+#define HEAPQ4_LCHILD_INDEX(i) ((HEAPQ4_ARITY*(i))+1)
+
+// Offset of the root so that every sibling group starts on a 32B boundary
+#define HEAPQ4_ALIGN_OFFSET (HEAPQ4_ARITY-1)
+
+//////////////////////////////////////////////////////////////////////
+// Create a 4-ary heap to store the given # of nodes from storage
+
+heapq4_t heapq4_create(size_t max_nodes, const node_memory_t* storage) {
+
+	heapq4_t heapq;
+
+	// Arena is page aligned
+	heapq.arena = arena_reserve(sizeof(heapq4_entry_t) *
+	                            (max_nodes + HEAPQ4_ALIGN_OFFSET),
+	                            g_options.search_huge_pages);
+
+	// Children of i live at 4i+1..4i+4, i.e. byte offset 32(i+1)
+	heapq.start = (heapq4_entry_t*)heapq.arena.start + HEAPQ4_ALIGN_OFFSET;
+	heapq.storage = storage;
+	heapq.count = 0;
+	heapq.total_count = 0;
+	heapq.capacity = max_nodes;
+
+	return heapq;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pack/unpack a node and move code into a frontier entry
+
+static frontier_entry_t frontier_entry(const node_memory_t* storage,
+                                       const tree_node_t* node,
+                                       uint8_t move) {
+	uint64_t ref = node_index(storage, node);
+	uint64_t key = (uint64_t)node_priority(node) + (move != MOVE_NONE);
+	assert(ref <= UINT32_MAX);
+	assert(key < (1 << 24));
+	return (key << 40) | (ref << 8) | move;
+}
+
+static tree_node_t* frontier_entry_node(const node_memory_t* storage,
+                                        frontier_entry_t e) {
+	return node_at(storage, (uint32_t)(e >> 8));
+}
+
+static size_t frontier_entry_key(frontier_entry_t e) {
+	return e >> 40;
+}
+
+static uint8_t frontier_entry_move(frontier_entry_t e) {
+	return e & 0xff;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is heap queue count
+
+size_t heapq4_count(const heapq4_t* q) {
+	return q->total_count;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is heap queue empty?
+
+int heapq4_empty(const heapq4_t* q) {
+	return q->count == 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* heapq4_peek(const heapq4_t* q) {
+	assert(!heapq4_empty(q));
+	return frontier_entry_node(q->storage, q->start[0]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node onto the heap
+
+void heapq4_enqueue(heapq4_t* q, tree_node_t* node) {
+	heapq4_enqueue_move(q, node, MOVE_NONE);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+// (iterative sift-up)
+
+void heapq4_enqueue_move(heapq4_t* q, tree_node_t* parent, uint8_t move) {
+
+	assert(q->count < q->capacity);
+
+	if (!arena_commit(&q->arena, (q->count + 1 + HEAPQ4_ALIGN_OFFSET) *
+	                  sizeof(heapq4_entry_t))) {
+		fprintf(stderr, "out of memory growing heapq4!\n");
+		exit(1);
+	}
+
+	heapq4_entry_t e = frontier_entry(q->storage, parent, move);
+	heapq4_entry_t* h = q->start;
+	size_t i = q->count++;
+	q->total_count++;
+
+	while (i > 0) {
+		size_t pi = HEAPQ4_PARENT_INDEX(i);
+		if (h[pi] <= e) { break; }
+		h[i] = h[pi];
+		i = pi;
+	}
+
+	h[i] = e;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop a node off the heap
+
+tree_node_t* heapq4_deque(heapq4_t* q) {
+	uint8_t move;
+	tree_node_t* rval = heapq4_deque_move(q, &move);
+	assert(move == MOVE_NONE);
+	return rval;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop an entry off the heap; move is MOVE_NONE for stored nodes
+// (iterative sift-down)
+
+tree_node_t* heapq4_deque_move(heapq4_t* q, uint8_t* move) {
+
+	assert(!heapq4_empty(q));
+
+	heapq4_entry_t* h = q->start;
+	tree_node_t* rval = frontier_entry_node(q->storage, h[0]);
+	*move = frontier_entry_move(h[0]);
+
+	size_t n = --q->count;
+	if (!n) { return rval; }
+
+	heapq4_entry_t e = h[n];
+	size_t i = 0;
+
+	while (1) {
+
+		size_t ci = HEAPQ4_LCHILD_INDEX(i);
+		if (ci >= n) { break; }
+
+		// Grandchildren span four sibling groups, i.e. two cache lines
+		size_t gi = HEAPQ4_LCHILD_INDEX(ci);
+		__builtin_prefetch(h + gi);
+		__builtin_prefetch(h + gi + 2*HEAPQ4_ARITY);
+
+		size_t end = ci + HEAPQ4_ARITY < n ? ci + HEAPQ4_ARITY : n;
+		size_t smallest = ci;
+		for (size_t j=ci+1; j<end; ++j) {
+			if (h[j] < h[smallest]) { smallest = j; }
+		}
+
+		if (e <= h[smallest]) { break; }
+
+		h[i] = h[smallest];
+		i = smallest;
+
+	}
+
+	h[i] = e;
+
+	return rval;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for heap
+
+void heapq4_destroy(heapq4_t* q) {
+	arena_release(&q->arena);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Create a bucket queue to store the given # of nodes
+
+bucketq_t* bucketq_create(size_t max_nodes, int lifo,
+                          const node_memory_t* storage) {
+	bucketq_t* q = calloc(1, sizeof(bucketq_t));
+	if (!q) {
+		fprintf(stderr, "out of memory creating bucketq!\n");
+		exit(1);
+	}
+	q->lifo = lifo;
+	q->storage = storage;
+	q->capacity = max_nodes;
+	q->bytes = sizeof(bucketq_t);
+	return q;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is bucket queue count
+
+size_t bucketq_count(const bucketq_t* q) {
+	return q->total_count;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is bucket queue empty?
+
+int bucketq_empty(const bucketq_t* q) {
+	return q->count == 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Advance min_cost to the lowest non-empty bucket
+
+static bucket_t* bucketq_front(bucketq_t* q) {
+	assert(!bucketq_empty(q));
+	while (q->buckets[q->min_cost].count == q->buckets[q->min_cost].next) {
+		++q->min_cost;
+		assert(q->min_cost <= MAX_CELLS);
+	}
+	return q->buckets + q->min_cost;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* bucketq_peek(bucketq_t* q) {
+	bucket_t* b = bucketq_front(q);
+	return frontier_entry_node(q->storage, q->lifo ? b->start[b->count-1] :
+	                           b->start[b->next]);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node into the bucket for its cost
+
+void bucketq_enqueue(bucketq_t* q, tree_node_t* node) {
+	bucketq_enqueue_move(q, node, MOVE_NONE);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+
+void bucketq_enqueue_move(bucketq_t* q, tree_node_t* parent, uint8_t move) {
+
+	assert(q->count < q->capacity);
+
+	frontier_entry_t e = frontier_entry(q->storage, parent, move);
+	size_t cost = frontier_entry_key(e);
+	assert(cost <= MAX_CELLS);
+	bucket_t* b = q->buckets + cost;
+
+	if (b->count == b->capacity) {
+		q->bytes += sizeof(frontier_entry_t) * (b->capacity ? b->capacity : 1024);
+		b->capacity = b->capacity ? 2*b->capacity : 1024;
+		b->start = realloc(b->start, sizeof(frontier_entry_t) * b->capacity);
+		if (!b->start) {
+			fprintf(stderr, "out of memory growing bucketq!\n");
+			exit(1);
+		}
+	}
+
+	b->start[b->count++] = e;
+
+	if (cost < q->min_cost) {
+		q->min_cost = cost;
+	}
+
+	q->count++;
+	q->total_count++;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop a node from the lowest non-empty bucket
+
+tree_node_t* bucketq_deque(bucketq_t* q) {
+	uint8_t move;
+	tree_node_t* rval = bucketq_deque_move(q, &move);
+	assert(move == MOVE_NONE);
+	return rval;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop an entry from the lowest non-empty bucket; move is MOVE_NONE for
+// stored nodes
+
+tree_node_t* bucketq_deque_move(bucketq_t* q, uint8_t* move) {
+
+	bucket_t* b = bucketq_front(q);
+	frontier_entry_t e = q->lifo ? b->start[--b->count] : b->start[b->next++];
+	tree_node_t* rval = frontier_entry_node(q->storage, e);
+	*move = frontier_entry_move(e);
+
+	// Rewind drained buckets so their slots get reused
+	if (b->next == b->count) {
+		b->next = b->count = 0;
+	}
+
+	--q->count;
+
+	return rval;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for bucket queue
+
+void bucketq_destroy(bucketq_t* q) {
+	for (size_t i=0; i<=MAX_CELLS; ++i) {
+		free(q->buckets[i].start);
+	}
+	free(q);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Create the frontier selected by kind to store the given # of nodes
+
+frontier_t frontier_create(int kind, size_t max_nodes,
+                           const node_memory_t* storage) {
+
+	frontier_t f;
+	memset(&f, 0, sizeof(f));
+
+	f.kind = kind;
+
+	if (kind == FRONTIER_HEAP) {
+		f.heapq = heapq_create(max_nodes);
+	} else if (kind == FRONTIER_HEAP4) {
+		f.heapq4 = heapq4_create(max_nodes, storage);
+	} else {
+		f.bucketq = bucketq_create(max_nodes, kind == FRONTIER_BUCKET_LIFO,
+		                           storage);
+	}
+
+	return f;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Total number of nodes ever enqueued
+
+size_t frontier_count(const frontier_t* f) {
+	return f->enqueued;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is frontier empty?
+
+int frontier_empty(const frontier_t* f) {
+	return f->enqueued == f->dequeued;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Is frontier at capacity?
+
+int frontier_full(const frontier_t* f) {
+	if (f->kind == FRONTIER_HEAP) {
+		return f->heapq.count >= f->heapq.capacity;
+	} else if (f->kind == FRONTIER_HEAP4) {
+		return f->heapq4.count >= f->heapq4.capacity;
+	} else {
+		return f->bucketq->count >= f->bucketq->capacity;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Can the frontier hold pending children (parent, move)?
+
+int frontier_supports_moves(int kind) {
+	return kind != FRONTIER_HEAP;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* frontier_peek(frontier_t* f) {
+	if (f->kind == FRONTIER_HEAP) {
+		return heapq_peek(&f->heapq);
+	} else if (f->kind == FRONTIER_HEAP4) {
+		return heapq4_peek(&f->heapq4);
+	} else {
+		return bucketq_peek(f->bucketq);
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node onto the frontier
+
+void frontier_enqueue(frontier_t* f, tree_node_t* node) {
+
+	double start = g_options.search_queue_timing ? now() : 0;
+
+	if (f->kind == FRONTIER_HEAP) {
+		heapq_enqueue(&f->heapq, node);
+	} else if (f->kind == FRONTIER_HEAP4) {
+		heapq4_enqueue(&f->heapq4, node);
+	} else {
+		bucketq_enqueue(f->bucketq, node);
+	}
+
+	++f->enqueued;
+
+	if (g_options.search_queue_timing) {
+		f->seconds += now() - start;
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+
+void frontier_enqueue_move(frontier_t* f, tree_node_t* parent, uint8_t move) {
+
+	double start = g_options.search_queue_timing ? now() : 0;
+
+	assert(frontier_supports_moves(f->kind));
+
+	if (f->kind == FRONTIER_HEAP4) {
+		heapq4_enqueue_move(&f->heapq4, parent, move);
+	} else {
+		bucketq_enqueue_move(f->bucketq, parent, move);
+	}
+
+	++f->enqueued;
+
+	if (g_options.search_queue_timing) {
+		f->seconds += now() - start;
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop the lowest cost node off the frontier
+
+tree_node_t* frontier_deque(frontier_t* f) {
+	uint8_t move;
+	tree_node_t* rval = frontier_deque_move(f, &move);
+	assert(move == MOVE_NONE);
+	return rval;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pop the lowest cost entry off the frontier; move is MOVE_NONE for
+// stored nodes, otherwise the node returned is the pending child's parent
+
+tree_node_t* frontier_deque_move(frontier_t* f, uint8_t* move) {
+
+	double start = g_options.search_queue_timing ? now() : 0;
+	tree_node_t* rval;
+
+	if (f->kind == FRONTIER_HEAP) {
+		rval = heapq_deque(&f->heapq);
+		*move = MOVE_NONE;
+	} else if (f->kind == FRONTIER_HEAP4) {
+		rval = heapq4_deque_move(&f->heapq4, move);
+	} else {
+		rval = bucketq_deque_move(f->bucketq, move);
+	}
+
+	++f->dequeued;
+
+	if (g_options.search_queue_timing) {
+		f->seconds += now() - start;
+	}
+
+	return rval;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for frontier
+
+void frontier_destroy(frontier_t* f) {
+	if (f->kind == FRONTIER_HEAP) {
+		heapq_destroy(&f->heapq);
+	} else if (f->kind == FRONTIER_HEAP4) {
+		heapq4_destroy(&f->heapq4);
+	} else {
+		bucketq_destroy(f->bucketq);
+	}
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -7,11 +7,75 @@
 // Data structure for heap based priority queue
 typedef struct heapq_struct {
 	tree_node_t** start; // Array of node pointers
+	arena_t arena;       // Backing memory, committed as the heap grows
 	size_t capacity;     // Maximum allowable queue size
 	size_t count;        // Number enqueued
 	size_t total_count;  // Total Number enqueued
 } heapq_t;
 
+// Move code of a frontier entry that holds a stored node, as opposed
+// to a pending child given by its parent plus (swap << 6) |
+// (color << 2) | dir, swap set if the color grows from its other end
+// (see game_swap_ends).
+#define MOVE_NONE 0xff
+#define MOVE_CREATE(color, dir, swap) \
+	((uint8_t)(((swap) << 6) | ((color) << 2) | (dir)))
+#define MOVE_COLOR(move) (((move) >> 2) & 0xf)
+#define MOVE_DIR(move) ((move) & 3)
+#define MOVE_SWAP(move) (((move) >> 6) & 1)
+
+// Entry for heapq4_t and bucketq_t: the priority key (node_priority,
+// the integer cost unless -P says otherwise) in the high 24 bits, the
+// node index into the arena in the next 32 bits and the move code in
+// the low 8 bits, so one integer comparison covers the priority and
+// the creation-order tie-break.
+typedef uint64_t frontier_entry_t;
+typedef frontier_entry_t heapq4_entry_t;
+
+// 4-ary heap with inline keys. Each group of 4 siblings fills half a
+// cache line, sifts are iterative, and children are prefetched.
+typedef struct heapq4_struct {
+	heapq4_entry_t* start; // Array of entries, sibling groups 32B aligned
+	arena_t arena;         // Backing memory, committed as the heap grows
+	const node_memory_t* storage; // Node store that entries index into
+	size_t capacity;     // Maximum allowable queue size
+	size_t count;        // Number enqueued
+	size_t total_count;  // Total Number enqueued
+} heapq4_t;
+
+// One cost level of a bucket queue: a growable array of entries,
+// read from the front (FIFO) or the back (LIFO).
+typedef struct bucket_struct {
+	frontier_entry_t* start; // Array of entries
+	size_t capacity;     // Allocated slots
+	size_t count;        // Slots written
+	size_t next;         // Next index to dequeue in FIFO order
+} bucket_t;
+
+// Monotone bucket queue indexed by integer cost. Node costs are
+// small integers bounded by MAX_CELLS, so enqueue and dequeue are O(1).
+typedef struct bucketq_struct {
+	bucket_t buckets[MAX_CELLS+1]; // One bucket per cost
+	int lifo;            // Dequeue most recent node within a cost
+	const node_memory_t* storage; // Node store that entries index into
+	size_t min_cost;     // No node is enqueued below this cost
+	size_t capacity;     // Maximum allowable queue size
+	size_t count;        // Number enqueued
+	size_t total_count;  // Total Number enqueued
+	size_t bytes;        // Bytes allocated, the queue and its buckets
+} bucketq_t;
+
+// Search frontier: one of the priority queues above, chosen at runtime.
+typedef struct frontier_struct {
+	int kind;            // FRONTIER_* from options.h
+	heapq_t heapq;       // Used by FRONTIER_HEAP
+	heapq4_t heapq4;     // Used by FRONTIER_HEAP4
+	bucketq_t* bucketq;  // Used by FRONTIER_BUCKET_*
+	size_t enqueued;     // Number of enqueue operations
+	size_t dequeued;     // Number of dequeue operations
+	double seconds;      // Time spent in them (with --queue-timing)
+} frontier_t;
+
 // First in, first-out queue implemented as an array of pointers.
 typedef struct queue_struct {
 	tree_node_t** start; // Array of node pointers
@@ -59,6 +123,161 @@ void heapq_destroy(heapq_t* q);
 
 
 
+//////////////////////////////////////////////////////////////////////
+// Create a 4-ary heap to store the given # of nodes from storage
+
+heapq4_t heapq4_create(size_t max_nodes, const node_memory_t* storage);
+
+//////////////////////////////////////////////////////////////////////
+// Is heap queue count
+
+size_t heapq4_count(const heapq4_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Is heap queue empty?
+
+int heapq4_empty(const heapq4_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* heapq4_peek(const heapq4_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node onto the heap
+
+void heapq4_enqueue(heapq4_t* q, tree_node_t* node);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+
+void heapq4_enqueue_move(heapq4_t* q, tree_node_t* parent, uint8_t move);
+
+//////////////////////////////////////////////////////////////////////
+// Pop a node off the heap
+
+tree_node_t* heapq4_deque(heapq4_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Pop an entry off the heap; move is MOVE_NONE for stored nodes
+
+tree_node_t* heapq4_deque_move(heapq4_t* q, uint8_t* move);
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for heap
+
+void heapq4_destroy(heapq4_t* q);
+
+
+
+//////////////////////////////////////////////////////////////////////
+// Create a bucket queue to store the given # of nodes
+
+bucketq_t* bucketq_create(size_t max_nodes, int lifo,
+                          const node_memory_t* storage);
+
+//////////////////////////////////////////////////////////////////////
+// Is bucket queue count
+
+size_t bucketq_count(const bucketq_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Is bucket queue empty?
+
+int bucketq_empty(const bucketq_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* bucketq_peek(bucketq_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node into the bucket for its cost
+
+void bucketq_enqueue(bucketq_t* q, tree_node_t* node);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+
+void bucketq_enqueue_move(bucketq_t* q, tree_node_t* parent, uint8_t move);
+
+//////////////////////////////////////////////////////////////////////
+// Pop a node from the lowest non-empty bucket
+
+tree_node_t* bucketq_deque(bucketq_t* q);
+
+//////////////////////////////////////////////////////////////////////
+// Pop an entry from the lowest non-empty bucket; move is MOVE_NONE for
+// stored nodes
+
+tree_node_t* bucketq_deque_move(bucketq_t* q, uint8_t* move);
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for bucket queue
+
+void bucketq_destroy(bucketq_t* q);
+
+
+
+//////////////////////////////////////////////////////////////////////
+// Create the frontier selected by kind to store the given # of nodes
+
+frontier_t frontier_create(int kind, size_t max_nodes,
+                           const node_memory_t* storage);
+
+//////////////////////////////////////////////////////////////////////
+// Total number of nodes ever enqueued
+
+size_t frontier_count(const frontier_t* f);
+
+//////////////////////////////////////////////////////////////////////
+// Is frontier empty?
+
+int frontier_empty(const frontier_t* f);
+
+//////////////////////////////////////////////////////////////////////
+// Is frontier at capacity?
+
+int frontier_full(const frontier_t* f);
+
+//////////////////////////////////////////////////////////////////////
+// Can the frontier hold pending children (parent, move)?
+
+int frontier_supports_moves(int kind);
+
+//////////////////////////////////////////////////////////////////////
+// Peek at the next item to be removed
+
+const tree_node_t* frontier_peek(frontier_t* f);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a node onto the frontier
+
+void frontier_enqueue(frontier_t* f, tree_node_t* node);
+
+//////////////////////////////////////////////////////////////////////
+// Enqueue a pending child: the move applied to a stored parent
+
+void frontier_enqueue_move(frontier_t* f, tree_node_t* parent, uint8_t move);
+
+//////////////////////////////////////////////////////////////////////
+// Pop the lowest cost node off the frontier
+
+tree_node_t* frontier_deque(frontier_t* f);
+
+//////////////////////////////////////////////////////////////////////
+// Pop the lowest cost entry off the frontier; move is MOVE_NONE for
+// stored nodes, otherwise the node returned is the pending child's parent
+
+tree_node_t* frontier_deque_move(frontier_t* f, uint8_t* move);
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for frontier
+
+void frontier_destroy(frontier_t* f);
+
+
+
 //////////////////////////////////////////////////////////////////////
 // QUEUE via flat array
 
@@ -6,6 +6,8 @@
 #include "queues.h"
 #include "extensions.h"
 
+#include <pthread.h>
+
 //////////////////////////////////////////////////////////////////////
 // Initialize Maximum number of nodes allowed, given a MB bound
 
@@ -15,8 +17,28 @@ void initialize_search( size_t* max_nodes,
 
 	*max_nodes = g_options.search_max_nodes;
 	if (! (*max_nodes) ) {
-		*max_nodes = floor( g_options.search_max_mb * MEGABYTE /
-				   sizeof(tree_node_t) );
+
+		double max_mb = g_options.search_max_mb;
+
+		// Leave a quarter of the free memory to the rest of the system
+		if (g_options.search_auto_storage) {
+			size_t available = available_memory();
+			if (available) {
+				max_mb = 0.75 * available / MEGABYTE;
+			}
+		}
+
+		double budget = max_mb * MEGABYTE;
+
+		*max_nodes = floor( budget / node_size(info) );
+
+		// With -t the table of their hashes comes out of the same
+		// budget; a smaller table only frees more room for nodes
+		if (g_options.node_transpositions) {
+			double table = ttable_peak_bytes(*max_nodes);
+			*max_nodes = table < budget ?
+				floor( (budget - table) / node_size(info) ) : 0;
+		}
 	}
 
 	if (!g_options.display_quiet) {
@@ -25,12 +47,19 @@ void initialize_search( size_t* max_nodes,
 		       "\n*               Initializing Search            *\n");
 
 		
-		printf("* Will search up to %'zu nodes (%'.2f MB) \n",
-		       *max_nodes, *max_nodes*(double)sizeof(tree_node_t)/MEGABYTE);
+		// The depth-first engines visit that many states but keep one
+		if (g_options.search_engine == ENGINE_DIJKSTRA) {
+			printf("* Will search up to %'zu nodes (%'.2f MB) \n",
+			       *max_nodes, *max_nodes*(double)node_size(info)/MEGABYTE);
+		} else {
+			printf("* Will visit up to %'zu states\n", *max_nodes);
+		}
   
-		printf("* Num Free cells at start is %'d\n\n",
+		printf("* Num Free cells at start is %'d\n",
 		       init_state->num_free);
 
+		printf("* Node size is %'zu bytes\n\n", node_size(info));
+
 		printf("* Initial State:\n");
 		game_print(info, init_state);
 
@@ -41,14 +70,14 @@ void initialize_search( size_t* max_nodes,
 }
 
 //////////////////////////////////////////////////////////////////////
-// Check if node contains a state with:
+// Check if state has:
 //    a) no free cell
 //    b) all colors connected by a path
 
-int is_solved(tree_node_t* node, const game_info_t* info){
+int is_solved(const game_state_t* state, const game_info_t* info){
 
-	if ( node->state.num_free == 0 && 
-	     node->state.completed == (1 << info->num_colors) - 1 ) {
+	if ( state->num_free == 0 && 
+	     state->completed == (1 << info->num_colors) - 1 ) {
 
 		return 1;
 		 			
@@ -57,96 +86,537 @@ int is_solved(tree_node_t* node, const game_info_t* info){
 }
 
 ///////////////////////////////////////////////////////////////////////
-// Adjust storage space for search nodes if deadends are found
+// Check if state contains a deadend, so no node is stored for it
 
-tree_node_t* deadend_mem_adjust(const game_info_t* info,
-                              tree_node_t* node,
-                              node_memory_t* storage) {
-	
-	// Ensure that node is the current node at endpoint of path so far
-	assert(node == storage->start + storage->count-1);
+int is_deadend(const game_info_t* info, const game_state_t* state) {
 
-	// Check for potential dead-ends
-	if (g_options.node_check_deadends &&
-      game_check_deadends(info, &node->state) ) {
+	return (g_options.node_check_deadends &&
+	        game_check_deadends(info, state)) ||
+		(g_options.node_check_patterns &&
+		 game_check_patterns(info, state)) ||
+		(g_options.node_check_regions &&
+		 game_check_regions(info, state) != REGIONS_OK) ||
+		(g_options.node_check_cuts &&
+		 game_check_cuts(info, state, NULL));
 
-		  assert(node == storage->start+storage->count-1);
+}
 
-		  // Count total nodes allocated and decrease them if dead-end is found
-		  assert( storage->count && node == storage->start + storage->count - 1 );
-  		--storage-> count;
+//////////////////////////////////////////////////////////////////////
+// Print the counters of the enabled search features on one line,
+// preceded by lead; return the number of counters printed
 
-		return 0;
+int search_stats_print(const search_stats_t* stats, const char* lead) {
+
+	int printed = 0;
+
+	if (g_options.search_engine == ENGINE_LDS) {
+		printf("%s discrepancies=%d", printed++ ? "" : lead,
+		       stats->discrepancies);
+	}
+
+	if (g_options.search_scored &&
+	    g_options.search_engine == ENGINE_DIJKSTRA) {
+		printf("%s priority=%s", printed++ ? "" : lead,
+		       g_options.search_priority_spec);
+	}
+
+	if (g_options.order_moves_on) {
+		printf("%s first=%'zu/%'zu", printed++ ? "" : lead,
+		       stats->solution_first, stats->solution_choices);
+	}
+
+	if (g_options.node_transpositions) {
+		printf("%s dup=%'zu", printed++ ? "" : lead,
+		       stats->duplicates_pruned);
+	}
+
+	if (g_options.node_check_patterns) {
+		printf("%s patterns=%'zu", printed++ ? "" : lead,
+		       stats->patterns_pruned);
+	}
+
+	if (g_options.node_check_regions) {
+		printf("%s isolated=%'zu stranded=%'zu", printed++ ? "" : lead,
+		       stats->regions_isolated, stats->regions_stranded);
+	}
+
+	if (g_options.node_forced) {
+		printf("%s forced=%'zu stuck=%'zu", printed++ ? "" : lead,
+		       stats->forced_moves, stats->forced_dead);
 	}
 
-	return node;
+	if (g_options.node_domains) {
+		printf("%s wipeouts=%'zu no-cells=%'zu picks=%'zu",
+		       printed++ ? "" : lead, stats->domain_wipeouts,
+		       stats->domain_stranded, stats->domain_picks);
+	}
+
+	if (g_options.node_check_cuts) {
+		printf("%s cuts=%'zu/%'zu (%'.1f%%, %'.0f ns/check)",
+		       printed++ ? "" : lead,
+		       stats->cuts_pruned, stats->cuts_checked,
+		       stats->cuts_checked ?
+		       100.0 * stats->cuts_pruned / stats->cuts_checked : 0.0,
+		       stats->cuts_checked ?
+		       stats->cuts_seconds * 1e9 / stats->cuts_checked : 0.0);
+	}
+
+	if (g_options.node_nogoods) {
+		printf("%s nogoods=%'zu (%'zu/%'zu hits/lookups, %'zu searched, "
+		       "%'zu evicted)", printed++ ? "" : lead, stats->nogood_pruned,
+		       stats->nogood_hits, stats->nogood_hits + stats->nogood_misses,
+		       stats->nogood_searches, stats->nogoods_evicted);
+	}
+
+	if (g_options.node_split) {
+		printf("%s splits=%'zu (%'zu dead, %'zu solved, %'zu searched, %'.3fs)",
+		       printed++ ? "" : lead, stats->splits, stats->split_dead,
+		       stats->split_solved, stats->split_searches,
+		       stats->split_seconds);
+	}
+
+	if (g_options.node_reclaim) {
+		printf("%s reclaimed=%'zu live=%'zu", printed++ ? "" : lead,
+		       stats->reclaimed, stats->peak_live);
+	}
+
+	if (g_options.node_deferred) {
+		printf("%s stored=%'zu (%'.1f B/node)", printed++ ? "" : lead,
+		       stats->stored, stats->enqueued ?
+		       stats->stored * (double)stats->node_bytes / stats->enqueued : 0.0);
+	}
+
+	if (g_options.display_memory) {
+		printf("%s startup=%'.3fms mem=%'.1fMB rss=%'.1fMB",
+		       printed++ ? "" : lead,
+		       stats->startup_seconds * 1e3,
+		       stats->committed_bytes / (double)MEGABYTE,
+		       stats->peak_rss_kb / 1024.0);
+	}
+
+	if (g_options.search_queue_timing) {
+		size_t ops = stats->enqueued + stats->dequeued;
+		printf("%s enq=%'zu deq=%'zu queue=%'.3fs (%'.1f Mops/s)",
+		       printed++ ? "" : lead,
+		       stats->enqueued, stats->dequeued, stats->queue_seconds,
+		       stats->queue_seconds > 0 ?
+		       ops / stats->queue_seconds / 1e6 : 0.0);
+	}
+
+	return printed;
 
 }
 
 //////////////////////////////////////////////////////////////////////
 // Animate sequence of moves up to node
 
-void report_solution( const tree_node_t* node, const game_info_t* info ) {
+void report_solution( const tree_node_t* node, const game_info_t* info,
+                      const node_memory_t* storage, game_state_t* scratch ) {
 
 		assert(node);
 
-		printf("Number of moves=%'g, Free cells=%'d\n",
-		       node->cost_to_node,
-		       node->state.num_free);
+		printf("Number of moves=%'d, Free cells=%'d\n",
+		       node_cost(node),
+		       node->num_free);
 		
 		printf("\n");
-		game_print(info, &node->state);
+		node_get_state(storage, node, scratch);
+		game_print(info, scratch);
 		
-		animate_solution(info, node);
+		animate_solution(info, storage, node, scratch);
 		delay_seconds(1.0);
 }
-////////////////////////////////////////////////////////////////////
-// Peforms Dijkstra  search
+//////////////////////////////////////////////////////////////////////
+// Everything the search loop works on, set up by game_dijkstra_search
 
-int game_dijkstra_search(const game_info_t* info,
-                const game_state_t* init_state,
-                double* elapsed_out,
-                size_t* nodes_out,
-                game_state_t* final_state) {
+typedef struct search_ctx_struct {
+	const game_info_t* info;
+	node_memory_t* storage;
+	frontier_t* pq;
+	ttable_t* tt;
+	nogood_cache_t* nogoods;
+	search_stats_t* stats;
+	deadend_fn check_deadends;     // Dead-end kernel for this board size
+	deadend_fn check_regions;      // Region kernel for this board size
+	domain_fn check_domains;       // Domain kernel for this board size
+	game_state_t* parent_state;    // Scratch state of the popped node
+	game_state_t* child_state;     // Scratch state of the child built
+	game_undo_log_t* undo;         // Moves to log for the DFS, or NULL
+	const tree_node_t* solution_node;
+	game_state_t* final_state;
+	size_t max_nodes;              // States the DFS may visit
+	size_t nodes;                  // States it visited so far
+	int max_discrepancies;         // Children past the first a DFS path
+	                               // may take (-1 for any number)
+	int cut_off;                   // Set once that limit skipped a child
+	cut_search_t cut_search;       // Cuts prune_domains found, reused by
+	int cut_search_ready;          // prune_cuts while this is set
+} search_ctx_t;
 
+//////////////////////////////////////////////////////////////////////
+// Pruning tests of the search loop; deadends/transpositions are the
+// options, passed as constants by the specialized loops below
 
-	// Max_nodes that fit in memory
-	size_t max_nodes;
+KERNEL_INLINE int prune_deadend(search_ctx_t* ctx, const game_state_t* state,
+                                const int deadends) {
+	return deadends && ctx->check_deadends(ctx->info, state);
+}
 
-	// Initialize Maximum number of nodes allowed, given a MB bound
-	initialize_search( &max_nodes, info, init_state );
+KERNEL_INLINE int prune_patterns(search_ctx_t* ctx, const game_state_t* state,
+                                 const int patterns) {
 
-	// Linearly allocate memory spcace for search nodes
-	node_memory_t storage = create_node_mem(max_nodes);
+	if (!patterns || !game_check_patterns(ctx->info, state)) {
+		return 0;
+	}
 
-	// Create Root node (uncomment code below)
-	tree_node_t* root = node_create(&storage, NULL, init_state);
+	++ctx->stats->patterns_pruned;
 
-	// Create Priority Queue
-	heapq_t pq = heapq_create(max_nodes);
+	return 1;
 
-	// While search is still ongoing, ensure solution is not defined
-	int result = SEARCH_IN_PROGRESS;
-	const tree_node_t* solution_node = NULL;
+}
+
+KERNEL_INLINE int prune_regions(search_ctx_t* ctx, const game_state_t* state,
+                                const int regions) {
+
+	if (!regions) {
+		return 0;
+	}
+
+	switch (ctx->check_regions(ctx->info, state)) {
+	case REGIONS_ISOLATED:
+		++ctx->stats->regions_isolated;
+		return 1;
+	case REGIONS_STRANDED:
+		++ctx->stats->regions_stranded;
+		return 1;
+	default:
+		return 0;
+	}
+
+}
+
+// Forced moves are applied to the state in place before it is
+// checked, so they run first; a color left stuck drops the child
+KERNEL_INLINE int prune_forced(search_ctx_t* ctx, game_state_t* state,
+                               const int forced) {
+
+	if (!forced) {
+		return 0;
+	}
+
+	int applied = game_apply_forced(ctx->info, state, ctx->undo);
+
+	if (applied < 0) {
+		++ctx->stats->forced_dead;
+		return 1;
+	}
+
+	ctx->stats->forced_moves += applied;
+
+	return 0;
+
+}
+
+// Domains may also pick the color the state moves next
+KERNEL_INLINE int prune_domains(search_ctx_t* ctx, game_state_t* state,
+                                const int domains) {
+
+	if (!domains) {
+		return 0;
+	}
+
+	ctx->cut_search_ready = 0;
+
+	switch (ctx->check_domains(ctx->info, state, &ctx->cut_search)) {
+	case DOMAINS_WIPEOUT:
+		++ctx->stats->domain_wipeouts;
+		return 1;
+	case DOMAINS_STRANDED:
+		++ctx->stats->domain_stranded;
+		return 1;
+	default:
+		ctx->stats->domain_picks += state->next_color != MAX_COLORS;
+		ctx->cut_search_ready = 1;
+		return 0;
+	}
+
+}
+
+// The cut check costs far more than a branch, so it is not a loop
+// specialization; it is timed to weigh that cost against its hits
+KERNEL_INLINE int prune_cuts(search_ctx_t* ctx, const game_state_t* state,
+                             const int cuts) {
+
+	if (!cuts) {
+		return 0;
+	}
 
-	// Record the timestamp search starts
 	double start = now();
+	int pruned = game_check_cuts(ctx->info, state, ctx->cut_search_ready ?
+	                             &ctx->cut_search : NULL);
+	ctx->cut_search_ready = 0;
 
-	// Adjust storage space for root node if deadends are found
-	root = deadend_mem_adjust(info, root, &storage);
-	
-	// If root node does not exist, no solution found
-	if (!root) {
+	ctx->stats->cuts_seconds += now() - start;
+	++ctx->stats->cuts_checked;
+	ctx->stats->cuts_pruned += pruned;
 
-		result = SEARCH_UNREACHABLE;
+	return pruned;
+
+}
+
+// Regions only their own colors can use are looked up in the nogood
+// cache; one not seen before is searched, if small enough, and the
+// verdict cached for every later state holding it
+KERNEL_INLINE int prune_nogoods(search_ctx_t* ctx, const game_state_t* state,
+                                const int nogoods) {
+
+	if (!nogoods) {
+		return 0;
+	}
+
+	region_t regions[MAX_COLORS];
+	size_t num_regions = game_exclusive_regions(ctx->info, state, regions);
+
+	for (size_t r=0; r<num_regions; ++r) {
+
+		const region_t* region = regions + r;
+
+		if (region->size > NOGOOD_MAX_CELLS) {
+			continue;
+		}
+
+		int outcome = nogood_lookup(ctx->nogoods, region->key);
+
+		if (outcome == NOGOOD_ABSENT) {
+			outcome = game_solve_region(ctx->info, state, region,
+			                            NOGOOD_MAX_NODES, NULL);
+			++ctx->stats->nogood_searches;
+			nogood_insert(ctx->nogoods, region->key, outcome);
+		}
+
+		if (outcome == REGION_DEAD) {
+			++ctx->stats->nogood_pruned;
+			return 1;
+		}
+
+	}
+
+	return 0;
+
+}
+
+KERNEL_INLINE int prune_duplicate(search_ctx_t* ctx, const game_state_t* state,
+                                  const int transpositions) {
+
+	if (!transpositions || ttable_insert(ctx->tt, state->hash)) {
+		return 0;
+	}
+
+	++ctx->stats->duplicates_pruned;
+
+	return 1;
+
+}
+
+enum {
+	SPLIT_MAX_FREE = 128,      // Most free cells of a state worth splitting
+	SPLIT_MAX_NODES = 1 << 12, // Node budget of each region of a split
+};
+
+// A region of a split, searched on its own (thread)
+typedef struct split_job_struct {
+	const game_info_t* info;
+	const game_state_t* state;
+	const region_t* region;
+	game_state_t solved;
+	int outcome;
+} split_job_t;
+
+static void* split_job_run(void* arg) {
+
+	split_job_t* job = arg;
+
+	job->outcome = game_solve_region(job->info, job->state, job->region,
+	                                 SPLIT_MAX_NODES, &job->solved);
+
+	return NULL;
+
+}
+
+static int region_size_compare(const void* a, const void* b) {
+	return ((const region_t*)a)->size - ((const region_t*)b)->size;
+}
+
+//////////////////////////////////////////////////////////////////////
+// When the free cells split into regions that share no color, each is
+// a puzzle of its own: search them separately, smallest first (or on
+// threads of their own with -j), and if all can be filled, fill them
+// into state. Return REGION_DEAD if one cannot be filled, and
+// REGION_UNKNOWN if the state does not split or a search gave up.
+
+static int search_split(search_ctx_t* ctx, game_state_t* state) {
+
+	const game_info_t* info = ctx->info;
+	search_stats_t* stats = ctx->stats;
+
+	// Early on, regions are rarely independent and too big to search
+	if (state->num_free > SPLIT_MAX_FREE) {
+		return REGION_UNKNOWN;
+	}
+
+	region_t regions[MAX_COLORS];
+	size_t num_regions = game_exclusive_regions(info, state, regions);
+
+	if (num_regions < 2) {
+		return REGION_UNKNOWN;
+	}
+
+	// Every free cell and live color must belong to one of them
+	bitboard_t cells;
+	memset(&cells, 0, sizeof(cells));
+	int colors = 0;
+
+	for (size_t r=0; r<num_regions; ++r) {
+		cells = bb_or(cells, regions[r].cells);
+		colors |= regions[r].colors;
+	}
+
+	if (colors != live_colors(info, state) ||
+	    !bb_equal_w(cells, state->free, BB_WORDS)) {
+		return REGION_UNKNOWN;
+	}
+
+	++stats->splits;
+
+	// A region already known to be dead or too hard settles it
+	for (size_t r=0; r<num_regions; ++r) {
+		int outcome = nogood_lookup(ctx->nogoods, regions[r].key);
+		if (outcome == REGION_DEAD) {
+			++stats->split_dead;
+			return REGION_DEAD;
+		} else if (outcome == REGION_UNKNOWN) {
+			return REGION_UNKNOWN;
+		}
+	}
+
+	qsort(regions, num_regions, sizeof(region_t), region_size_compare);
+
+	split_job_t jobs[MAX_COLORS];
+	size_t num_jobs = 0;
+	int outcome = REGION_SOLVABLE;
+
+	for (size_t r=0; r<num_regions; ++r) {
+		split_job_t job = { info, state, regions + r };
+		jobs[r] = job;
+	}
+
+	if (g_options.search_threads) {
+
+		pthread_t threads[MAX_COLORS];
+		int started[MAX_COLORS];
+
+		// This thread takes the first region; one that cannot get a
+		// thread of its own is searched here too
+		for (size_t r=1; r<num_regions; ++r) {
+			started[r] = !pthread_create(threads + r, NULL, split_job_run,
+			                             jobs + r);
+		}
+
+		split_job_run(jobs);
+
+		for (size_t r=1; r<num_regions; ++r) {
+			if (started[r]) {
+				pthread_join(threads[r], NULL);
+			} else {
+				split_job_run(jobs + r);
+			}
+		}
+
+		num_jobs = num_regions;
 
 	} else {
 
-        // Enqueue root
-        heapq_enqueue(&pq, root);	
+		while (num_jobs < num_regions &&
+		       (num_jobs == 0 || jobs[num_jobs-1].outcome == REGION_SOLVABLE)) {
+			split_job_run(jobs + num_jobs++);
+		}
 
 	}
 
+	stats->split_searches += num_jobs;
+
+	for (size_t r=0; r<num_jobs; ++r) {
+		nogood_insert(ctx->nogoods, regions[r].key, jobs[r].outcome);
+		if (jobs[r].outcome == REGION_DEAD) {
+			outcome = REGION_DEAD;
+		} else if (jobs[r].outcome == REGION_UNKNOWN &&
+		           outcome != REGION_DEAD) {
+			outcome = REGION_UNKNOWN;
+		}
+	}
+
+	if (outcome == REGION_DEAD) {
+		++stats->split_dead;
+	}
+
+	if (outcome != REGION_SOLVABLE) {
+		return outcome;
+	}
+
+	for (size_t r=0; r<num_regions; ++r) {
+		game_merge_region(info, state, regions + r, &jobs[r].solved);
+	}
+
+	++stats->split_solved;
+
+	return REGION_SOLVABLE;
+
+}
+
+// A state that splits into independent regions is dropped if one of
+// them cannot be filled, or filled in full if all can; timed like the
+// cut check
+KERNEL_INLINE int prune_split(search_ctx_t* ctx, game_state_t* state,
+                              const int split) {
+
+	if (!split) {
+		return 0;
+	}
+
+	double start = now();
+	int outcome = search_split(ctx, state);
+
+	ctx->stats->split_seconds += now() - start;
+
+	return outcome == REGION_DEAD;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Expand nodes until a solution is found, the frontier runs dry or
+// storage fills up; instantiated per pruning configuration
+
+KERNEL_INLINE int search_loop(search_ctx_t* ctx, const int deadends,
+                              const int regions, const int transpositions) {
+
+	const game_info_t* info = ctx->info;
+	node_memory_t* storage = ctx->storage;
+	frontier_t* pq = ctx->pq;
+	search_stats_t* stats = ctx->stats;
+	game_state_t* parent_state = ctx->parent_state;
+	game_state_t* child_state = ctx->child_state;
+
+	int deferred = g_options.node_deferred;
+	int cuts = g_options.node_check_cuts;
+	int forced = g_options.node_forced;
+	int patterns = g_options.node_check_patterns;
+	int domains = g_options.node_domains;
+	int nogoods = g_options.node_nogoods;
+	int split = g_options.node_split;
+	const int* move_weights = g_options.order_moves_on ?
+		g_options.order_moves : NULL;
+	int result = SEARCH_IN_PROGRESS;
+
 	/**
 	 * FILL IN THE CODE BELOW TO PERFORM DIJKSTRA OVER THE POSSIBLE 
 	 * MOVES TO SOLVE FLOW GAME
@@ -157,86 +627,742 @@ int game_dijkstra_search(const game_info_t* info,
 	while (result == SEARCH_IN_PROGRESS) {
 
 		// If priority queue is empty, no solution found
-		if (heapq_empty(&pq)) {
+		if (frontier_empty(pq)) {
       		result = SEARCH_UNREACHABLE;
       		break;
     	}
 
 		// Remove node from Queue, in order to generate its successors
-		tree_node_t* n = heapq_deque(&pq);
+		uint8_t move;
+		tree_node_t* n = frontier_deque_move(pq, &move);
 		assert(n);
 
-		// Get next color to explore its 4 directions
-		game_state_t* parent_state = &n->state;
+		// A pending child is only built now that it has been popped
+		node_get_state(storage, n, parent_state);
+
+		if (move != MOVE_NONE) {
+
+			tree_node_t* parent = n;
+
+			if (MOVE_SWAP(move)) {
+				game_swap_ends(info, parent_state, MOVE_COLOR(move), NULL);
+			}
+
+			game_make_move(info, parent_state,
+			               MOVE_COLOR(move), MOVE_DIR(move));
+
+			// The frontier entry's reference on the parent passes to n
+			n = NULL;
+			if (!prune_forced(ctx, parent_state, forced) &&
+			    !prune_deadend(ctx, parent_state, deadends) &&
+			    !prune_patterns(ctx, parent_state, patterns) &&
+			    !prune_regions(ctx, parent_state, regions) &&
+			    !prune_domains(ctx, parent_state, domains) &&
+			    !prune_nogoods(ctx, parent_state, nogoods) &&
+			    !prune_cuts(ctx, parent_state, cuts) &&
+			    !prune_duplicate(ctx, parent_state, transpositions) &&
+			    !prune_split(ctx, parent_state, split)) {
+
+				n = node_create(storage, parent, parent_state);
+
+				if (!n) {
+					result = SEARCH_FULL;
+					break;
+				}
+
+			}
+
+			--parent->num_children;
+
+			if (!n) {
+				if (g_options.node_reclaim) {
+					stats->reclaimed += node_release_dead(storage, parent);
+				}
+				continue;
+			}
+
+			if ( is_solved(parent_state, info) ) {
+				result = SEARCH_SUCCESS;
+				ctx->solution_node = n;
+				*ctx->final_state = *parent_state;
+				break;
+			}
+
+		}
+
+		// Every color is complete but cells are left free: no move
+		// can fix that, so the node has no children
+		if (parent_state->completed == (1 << info->num_colors) - 1) {
+			if (g_options.node_reclaim) {
+				stats->reclaimed += node_release_dead(storage, n);
+			}
+			continue;
+		}
 
+		// Get next color to explore its 4 directions
 	    // (use game_next_move_color function in engine.h)
 		int color = game_next_move_color(info, parent_state);
 
+		// With -b it may grow from its other end, which then becomes
+		// the head of the children
+		int swap = game_pick_end(info, parent_state, color);
+
+		if (swap) {
+			game_swap_ends(info, parent_state, color, NULL);
+		}
+
 		// Check move in that direction is possible 
 		// Within the rules of the game (see engine.h)
-		for (int dir=0; dir<4; ++dir) {
+		int legal_dirs = game_legal_dirs(info, parent_state, color);
 
-			if (game_can_move(info, &n->state, color, dir)) {
-				
-				// Create child node
-				tree_node_t* child = node_create(&storage, n, parent_state);
+		// Best moves first with -O; equal priorities pop in the order
+		// children are made
+		uint8_t order[4];
+		int num_moves = game_order_moves(info, parent_state, color,
+		                                 legal_dirs, move_weights, order);
+
+		for (int m=0; m<num_moves; ++m) {
 
-				// In no more space in memory, end search (more nodes in pq than max_nodes)
-				if (!child) {
+			int dir = order[m];
+
+			// Enqueue (n, move) instead of building the child
+			if (deferred) {
+
+				if (frontier_full(pq)) {
 					result = SEARCH_FULL;
 					break;
 				}
 
-				// Update child state given the direction
-				game_make_move(info, &child->state, color, dir);
-
+				++n->num_children;
+				frontier_enqueue_move(pq, n, MOVE_CREATE(color, dir, swap));
+				continue;
 
-				// Remove node if new position creates a deadend 
-				child = deadend_mem_adjust(info, child, &storage);
+			}
+			
+			// Update child state given the direction
+			memcpy(child_state, parent_state, sizeof(game_state_t));
+			game_make_move(info, child_state, color, dir);
 
-				if (child) {
-				
-				// Check if game is solved (uncomment code below)
-				if ( is_solved(child, info) ) {          
-					result = SEARCH_SUCCESS;
-					solution_node = child;
-					*final_state = solution_node->state;
-					break;     
-				}
+			// Follow up with the forced moves, then skip child if
+			// a color got stuck, the position creates a deadend,
+			// a free region or cell it cannot fill (now or in a
+			// cached search of the region) or a bottleneck two
+			// colors need, or if the same board was already
+			// generated. A child that splits into regions that
+			// can all be filled comes back solved.
+			if (prune_forced(ctx, child_state, forced) ||
+			    prune_deadend(ctx, child_state, deadends) ||
+			    prune_patterns(ctx, child_state, patterns) ||
+			    prune_regions(ctx, child_state, regions) ||
+			    prune_domains(ctx, child_state, domains) ||
+			    prune_nogoods(ctx, child_state, nogoods) ||
+			    prune_cuts(ctx, child_state, cuts) ||
+			    prune_duplicate(ctx, child_state, transpositions) ||
+			    prune_split(ctx, child_state, split)) {
+				continue;
+			}
 
-				// Add child to the queue
-				heapq_enqueue(&pq, child);
+			// Create child node
+			tree_node_t* child = node_create(storage, n, child_state);
 
-				}
+			// In no more space in memory, end search (more nodes in pq than max_nodes)
+			if (!child) {
+				result = SEARCH_FULL;
+				break;
+			}
+			
+			// Check if game is solved (uncomment code below)
+			if ( is_solved(child_state, info) ) {          
+				result = SEARCH_SUCCESS;
+				ctx->solution_node = child;
+				*ctx->final_state = *child_state;
+				break;     
 			}
+
+			// Add child to the queue
+			frontier_enqueue(pq, child);
+		}
+
+		// Give back the node and its ancestors if no child survived
+		if (result == SEARCH_IN_PROGRESS && g_options.node_reclaim) {
+			stats->reclaimed += node_release_dead(storage, n);
 		}
 	}
 
 	/**
 	 * END OF FILL IN CODE SECTION
 	 */
+
+	return result;
+
+}
+
+#define SEARCH_LOOP_KERNEL(DEADENDS, REGIONS, TRANSPOSITIONS)           \
+	static int                                                          \
+	search_loop_##DEADENDS##REGIONS##TRANSPOSITIONS(search_ctx_t* ctx) { \
+		return search_loop(ctx, DEADENDS, REGIONS, TRANSPOSITIONS);     \
+	}
+
+SEARCH_LOOP_KERNEL(0, 0, 0)
+SEARCH_LOOP_KERNEL(0, 0, 1)
+SEARCH_LOOP_KERNEL(0, 1, 0)
+SEARCH_LOOP_KERNEL(0, 1, 1)
+SEARCH_LOOP_KERNEL(1, 0, 0)
+SEARCH_LOOP_KERNEL(1, 0, 1)
+SEARCH_LOOP_KERNEL(1, 1, 0)
+SEARCH_LOOP_KERNEL(1, 1, 1)
+
+static int search_loop_generic(search_ctx_t* ctx) {
+	return search_loop(ctx, g_options.node_check_deadends,
+	                   g_options.node_check_regions,
+	                   g_options.node_transpositions);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Walk the solution path back to the root, counting the states with a
+// choice of moves and those where the path took the first one (-O)
+
+static void count_first_moves(search_ctx_t* ctx) {
+
+	const game_info_t* info = ctx->info;
+	const node_memory_t* storage = ctx->storage;
+	game_state_t* parent_state = ctx->parent_state;
+	game_state_t* child_state = ctx->child_state;
+
+	const tree_node_t* node = ctx->solution_node;
+	const tree_node_t* parent;
+
+	while ((parent = node_parent(storage, node))) {
+
+		node_get_state(storage, parent, parent_state);
+		node_get_state(storage, node, child_state);
+
+		int color = game_next_move_color(info, parent_state);
+
+		if (game_pick_end(info, parent_state, color)) {
+			game_swap_ends(info, parent_state, color, NULL);
+		}
+
+		uint8_t order[4];
+		int num_moves = game_order_moves(info, parent_state, color,
+		                                 game_legal_dirs(info, parent_state,
+		                                                 color),
+		                                 g_options.order_moves, order);
+
+		if (num_moves > 1) {
+
+			// The first move goes into the cell next to the head, and
+			// the cell records the direction it was entered from
+			pos_t pos = info->neighbors[parent_state->pos[color]][order[0]];
+			cell_t cell = child_state->cells[pos];
+
+			++ctx->stats->solution_choices;
+			ctx->stats->solution_first +=
+				cell_get_type(cell) == TYPE_PATH &&
+				cell_get_color(cell) == color &&
+				cell_get_direction(cell) == order[0];
+
+		}
+
+		node = parent;
+
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////
+// Peforms Dijkstra  search
+
+int game_dijkstra_search(const game_info_t* info,
+                const game_state_t* init_state,
+                double* elapsed_out,
+                size_t* nodes_out,
+                search_stats_t* stats_out,
+                game_state_t* final_state) {
+
+
+	// Max_nodes that fit in memory
+	size_t max_nodes;
+
+	// Initialize Maximum number of nodes allowed, given a MB bound
+	initialize_search( &max_nodes, info, init_state );
+
+	// Startup latency covers storage, frontier and root setup
+	double setup_start = now();
+	peak_rss_reset();
+
+	// Linearly allocate memory spcace for search nodes
+	node_memory_t storage = create_node_mem(info, max_nodes);
+
+	// Nodes only keep the part of the state that belongs to this board;
+	// states are unpacked into, and children built in, these scratch
+	// copies so only children that survive pruning take a node.
+	game_state_t parent_state = *init_state;
+	game_state_t child_state = *init_state;
+
+	// Create Priority Queue. Deferred children need a frontier whose
+	// entries carry a move; each stored node enqueues at most 4 of them.
+	int deferred = g_options.node_deferred;
+	int frontier_kind = g_options.search_frontier;
+	if (deferred && !frontier_supports_moves(frontier_kind)) {
+		frontier_kind = FRONTIER_HEAP4;
+	}
+
+	// Buckets hold one cost each, in increasing order; scored
+	// priorities (-P) need not be either
+	if (g_options.search_scored &&
+	    (frontier_kind == FRONTIER_BUCKET_FIFO ||
+	     frontier_kind == FRONTIER_BUCKET_LIFO)) {
+		frontier_kind = FRONTIER_HEAP4;
+	}
+
+	frontier_t pq = frontier_create(frontier_kind,
+	                                deferred ? 4*max_nodes : max_nodes,
+	                                &storage);
+
+	// Create set of already generated states
+	search_stats_t stats;
+	memset(&stats, 0, sizeof(stats));
+
+	ttable_t tt;
+	memset(&tt, 0, sizeof(tt));
+	if (g_options.node_transpositions) {
+		tt = ttable_create(max_nodes);
+	}
+
+	// Outcomes of the regions searched by prune_nogoods and prune_split
+	nogood_cache_t nogoods;
+	memset(&nogoods, 0, sizeof(nogoods));
+	if (g_options.node_nogoods || g_options.node_split) {
+		nogoods = nogood_create(NOGOOD_ENTRIES);
+	}
+
+	// While search is still ongoing, ensure solution is not defined
+	int result = SEARCH_IN_PROGRESS;
+	const tree_node_t* solution_node = NULL;
+
+	// Record the timestamp search starts
+	double start = now();
+	stats.startup_seconds = start - setup_start;
+
+	// If root state is a deadend, no solution found
+	if (is_deadend(info, init_state)) {
+
+		result = SEARCH_UNREACHABLE;
+
+	} else {
+
+		// Create Root node
+		tree_node_t* root = node_create(&storage, NULL, init_state);
+		assert(root);
+
+		// Root is the first state seen
+		if (g_options.node_transpositions) {
+			ttable_insert(&tt, init_state->hash);
+		}
+
+        // Enqueue root
+        frontier_enqueue(&pq, root);	
+
+	}
+
+	search_ctx_t ctx = {
+		info, &storage, &pq, &tt, &nogoods, &stats,
+		game_check_deadends, game_check_regions, game_check_domains,
+		&parent_state, &child_state, NULL, NULL, final_state
+	};
+
+	if (result == SEARCH_IN_PROGRESS) {
+
+		if (g_options.search_generic) {
+
+			result = search_loop_generic(&ctx);
+
+		} else {
+
+			// Pick the loop and pruning kernels once for this puzzle
+			static int (* const loops[2][2][2])(search_ctx_t*) = {
+				{ { search_loop_000, search_loop_001 },
+				  { search_loop_010, search_loop_011 } },
+				{ { search_loop_100, search_loop_101 },
+				  { search_loop_110, search_loop_111 } },
+			};
+
+			ctx.check_deadends = game_deadend_kernel(info);
+			ctx.check_regions = game_regions_kernel(info);
+			ctx.check_domains = game_domains_kernel(info);
+			result = loops[!!g_options.node_check_deadends]
+				[!!g_options.node_check_regions]
+				[!!g_options.node_transpositions](&ctx);
+
+		}
+
+	}
+
+	solution_node = ctx.solution_node;
+
+	if (result == SEARCH_SUCCESS && g_options.order_moves_on) {
+		count_first_moves(&ctx);
+	}
+
 				
 	// Get Stats
 	double elapsed = now() - start;
 	if (elapsed_out) { *elapsed_out = elapsed; }
-	if (nodes_out)   { *nodes_out = heapq_count(&pq); }
+	if (nodes_out)   { *nodes_out = frontier_count(&pq); }
+	stats.enqueued = pq.enqueued;
+	stats.dequeued = pq.dequeued;
+	stats.queue_seconds = pq.seconds;
+	stats.committed_bytes = storage.arena.committed +
+		storage.cold_arena.committed + pq.heapq.arena.committed +
+		pq.heapq4.arena.committed + (pq.bucketq ? pq.bucketq->bytes : 0) +
+		tt.capacity * sizeof(uint64_t);
+	stats.peak_rss_kb = peak_rss_kb();
+	stats.peak_live = storage.peak_live;
+	stats.stored = storage.count;
+	stats.node_bytes = sizeof(tree_node_t) + storage.cold_stride;
+	stats.nogood_hits = nogoods.hits;
+	stats.nogood_misses = nogoods.misses;
+	stats.nogoods_evicted = nogoods.evicted;
+	if (stats_out)   { *stats_out = stats; }
 
 	// Report soultion
 	if( result == SEARCH_SUCCESS
 	    && g_options.display_animate
 	    && !g_options.display_quiet )
-		report_solution( solution_node, info );
+		report_solution( solution_node, info, &storage, &parent_state );
 
 	// Report next node in Queue
 	if (result == SEARCH_FULL && g_options.display_diagnostics) {
 		
 		printf("here's the lowest cost thing on the queue:\n");		
-		node_diagnostics(info, heapq_peek(&pq));				
+		node_diagnostics(info, frontier_peek(&pq));				
 	}
 
   	// Free all memory used by search nodes
-	free(storage.start);
-	heapq_destroy(&pq);
+	destroy_node_mem(&storage);
+	frontier_destroy(&pq);
+	if (g_options.node_transpositions) {
+		ttable_destroy(&tt);
+	}
+	if (g_options.node_nogoods || g_options.node_split) {
+		nogood_destroy(&nogoods);
+	}
+
+	return result;
+
+}
+
+// A state on the path of the depth-first search
+typedef struct dfs_frame_struct {
+	uint8_t color;         // Color that moves next from it
+	uint8_t order;         // Its moves not tried yet, 2 bits each, next
+	                       // one lowest (see game_order_moves)
+	uint8_t num_moves;     // Number of moves it had
+	uint8_t left;          // Number not tried yet
+	uint8_t discrepancies; // Children past the first taken to get here
+	uint8_t tried;         // Set once a child got past the pruning
+	uint16_t mark;         // Undo log length at the state
+} dfs_frame_t;
+
+// Frame for state, which moves the color game_next_move_color picks;
+// with -b its ends are swapped first if game_pick_end says so, and the
+// swap logged in undo before the frame's mark
+KERNEL_INLINE dfs_frame_t dfs_frame(const game_info_t* info,
+                                    game_state_t* state,
+                                    game_undo_log_t* undo,
+                                    const int* move_weights,
+                                    int discrepancies) {
+
+	int color = game_next_move_color(info, state);
+
+	if (game_pick_end(info, state, color)) {
+		game_swap_ends(info, state, color, undo);
+	}
+
+	size_t mark = undo->count;
+
+	uint8_t order[4];
+	int num_moves = game_order_moves(info, state, color,
+	                                 game_legal_dirs(info, state, color),
+	                                 move_weights, order);
+
+	dfs_frame_t frame = { color, 0, num_moves, num_moves, discrepancies,
+	                      0, mark };
+
+	for (int m=num_moves-1; m>=0; --m) {
+		frame.order = (frame.order << 2) | order[m];
+	}
+
+	return frame;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Depth-first search loop: a single state, made and unmade in place,
+// with the same pruning tests as search_loop. Every path to a solution
+// fills the same cells, so going deep first gives up none of the
+// optimality Dijkstra has here. Children are taken in the order
+// game_order_moves gives them, which is direction order without -O;
+// once one has survived the tests, each later one is a discrepancy,
+// and a path takes at most ctx->max_discrepancies.
+
+KERNEL_INLINE int dfs_loop(search_ctx_t* ctx, const int deadends,
+                           const int regions, const int transpositions) {
+
+	const game_info_t* info = ctx->info;
+	game_state_t* state = ctx->parent_state;
+	game_undo_log_t* undo = ctx->undo;
+
+	int cuts = g_options.node_check_cuts;
+	int forced = g_options.node_forced;
+	int patterns = g_options.node_check_patterns;
+	int domains = g_options.node_domains;
+	int nogoods = g_options.node_nogoods;
+	int split = g_options.node_split;
+	int max_discrepancies = ctx->max_discrepancies;
+	const int* move_weights = g_options.order_moves_on ?
+		g_options.order_moves : NULL;
+
+	// One frame per state on the path, the root included
+	dfs_frame_t stack[MAX_CELLS+1];
+	size_t depth = 0;
+	int result = SEARCH_UNREACHABLE;
+
+	if (state->completed != (1 << info->num_colors) - 1) {
+		stack[depth++] = dfs_frame(info, state, undo, move_weights, 0);
+	}
+
+	while (depth) {
+
+		dfs_frame_t* frame = stack + depth - 1;
+
+		// Out of moves: back up to the state before this one
+		if (!frame->left) {
+			if (--depth) {
+				game_undo_moves(info, state, undo, stack[depth-1].mark);
+			}
+			continue;
+		}
+
+		int discrepancies = frame->discrepancies + frame->tried;
+
+		if (max_discrepancies >= 0 && discrepancies > max_discrepancies) {
+			ctx->cut_off = 1;
+			frame->left = 0;
+			continue;
+		}
+
+		int dir = frame->order & 3;
+		frame->order >>= 2;
+		--frame->left;
+
+		game_make_logged_move(info, state, frame->color, dir, undo);
+
+		// Same tests, in the same order, as the Dijkstra children
+		if (prune_forced(ctx, state, forced) ||
+		    prune_deadend(ctx, state, deadends) ||
+		    prune_patterns(ctx, state, patterns) ||
+		    prune_regions(ctx, state, regions) ||
+		    prune_domains(ctx, state, domains) ||
+		    prune_nogoods(ctx, state, nogoods) ||
+		    prune_cuts(ctx, state, cuts) ||
+		    prune_duplicate(ctx, state, transpositions) ||
+		    prune_split(ctx, state, split)) {
+			game_undo_moves(info, state, undo, frame->mark);
+			continue;
+		}
+
+		frame->tried = 1;
+
+		if (ctx->nodes >= ctx->max_nodes) {
+			result = SEARCH_FULL;
+			break;
+		}
+		++ctx->nodes;
+
+		if (is_solved(state, info)) {
+
+			result = SEARCH_SUCCESS;
+			*ctx->final_state = *state;
+
+			// The path took the last move tried from every frame
+			for (size_t d=0; d<depth; ++d) {
+				if (stack[d].num_moves > 1) {
+					++ctx->stats->solution_choices;
+					ctx->stats->solution_first +=
+						stack[d].left + 1 == stack[d].num_moves;
+				}
+			}
+
+			break;
+
+		}
+
+		// Every color is complete but cells are left free
+		if (state->completed == (1 << info->num_colors) - 1) {
+			game_undo_moves(info, state, undo, frame->mark);
+			continue;
+		}
+
+		stack[depth++] = dfs_frame(info, state, undo, move_weights,
+		                           discrepancies);
+
+	}
+
+	return result;
+
+}
+
+#define DFS_LOOP_KERNEL(DEADENDS, REGIONS, TRANSPOSITIONS)              \
+	static int                                                          \
+	dfs_loop_##DEADENDS##REGIONS##TRANSPOSITIONS(search_ctx_t* ctx) {   \
+		return dfs_loop(ctx, DEADENDS, REGIONS, TRANSPOSITIONS);        \
+	}
+
+DFS_LOOP_KERNEL(0, 0, 0)
+DFS_LOOP_KERNEL(0, 0, 1)
+DFS_LOOP_KERNEL(0, 1, 0)
+DFS_LOOP_KERNEL(0, 1, 1)
+DFS_LOOP_KERNEL(1, 0, 0)
+DFS_LOOP_KERNEL(1, 0, 1)
+DFS_LOOP_KERNEL(1, 1, 0)
+DFS_LOOP_KERNEL(1, 1, 1)
+
+static int dfs_loop_generic(search_ctx_t* ctx) {
+	return dfs_loop(ctx, g_options.node_check_deadends,
+	                g_options.node_check_regions,
+	                g_options.node_transpositions);
+}
+
+////////////////////////////////////////////////////////////////////
+// Performs depth-first search, or limited discrepancy search
+
+int game_dfs_search(const game_info_t* info,
+                    const game_state_t* init_state,
+                    double* elapsed_out,
+                    size_t* nodes_out,
+                    search_stats_t* stats_out,
+                    game_state_t* final_state) {
+
+	// The node budget is the one Dijkstra would get; only the path
+	// being searched is kept, so it bounds time rather than memory,
+	// and running out of it is reported as such (see flow_solver.c)
+	size_t max_nodes;
+	initialize_search( &max_nodes, info, init_state );
+
+	double setup_start = now();
+	peak_rss_reset();
+
+	game_state_t state = *init_state;
+	game_undo_log_t undo;
+	undo.count = 0;
+
+	search_stats_t stats;
+	memset(&stats, 0, sizeof(stats));
+
+	ttable_t tt;
+	memset(&tt, 0, sizeof(tt));
+	if (g_options.node_transpositions) {
+		tt = ttable_create(max_nodes);
+	}
+
+	nogood_cache_t nogoods;
+	memset(&nogoods, 0, sizeof(nogoods));
+	if (g_options.node_nogoods || g_options.node_split) {
+		nogoods = nogood_create(NOGOOD_ENTRIES);
+	}
+
+	double start = now();
+	stats.startup_seconds = start - setup_start;
+
+	search_ctx_t ctx = {
+		info, NULL, NULL, &tt, &nogoods, &stats,
+		game_check_deadends, game_check_regions, game_check_domains,
+		&state, NULL, &undo, NULL, final_state,
+		max_nodes, 1, -1, 0
+	};
+
+	int (*loop)(search_ctx_t*) = dfs_loop_generic;
+
+	if (!g_options.search_generic) {
+
+		static int (* const loops[2][2][2])(search_ctx_t*) = {
+			{ { dfs_loop_000, dfs_loop_001 },
+			  { dfs_loop_010, dfs_loop_011 } },
+			{ { dfs_loop_100, dfs_loop_101 },
+			  { dfs_loop_110, dfs_loop_111 } },
+		};
+
+		ctx.check_deadends = game_deadend_kernel(info);
+		ctx.check_regions = game_regions_kernel(info);
+		ctx.check_domains = game_domains_kernel(info);
+		loop = loops[!!g_options.node_check_deadends]
+			[!!g_options.node_check_regions]
+			[!!g_options.node_transpositions];
+
+	}
+
+	int result = SEARCH_UNREACHABLE;
+	int lds = g_options.search_engine == ENGINE_LDS;
+
+	if (is_deadend(info, init_state)) {
+
+		ctx.nodes = 0;
+
+	} else {
+
+		// Limited discrepancy search runs the loop again with one more
+		// discrepancy allowed until it stops skipping children. A state
+		// seen under a lower limit may hold more now, so the table of
+		// seen states starts over every time.
+		int limit = 0;
+
+		do {
+
+			if (lds) {
+				ctx.max_discrepancies = limit++;
+				ctx.cut_off = 0;
+			}
+
+			if (g_options.node_transpositions) {
+				ttable_clear(&tt);
+				ttable_insert(&tt, init_state->hash);
+			}
+
+			result = loop(&ctx);
+
+		} while (lds && result == SEARCH_UNREACHABLE && ctx.cut_off);
+
+		stats.discrepancies = ctx.max_discrepancies;
+
+	}
+
+	double elapsed = now() - start;
+	if (elapsed_out) { *elapsed_out = elapsed; }
+	if (nodes_out)   { *nodes_out = ctx.nodes; }
+	stats.committed_bytes = sizeof(state) + sizeof(undo) +
+		tt.capacity * sizeof(uint64_t);
+	stats.peak_rss_kb = peak_rss_kb();
+	stats.nogood_hits = nogoods.hits;
+	stats.nogood_misses = nogoods.misses;
+	stats.nogoods_evicted = nogoods.evicted;
+	if (stats_out)   { *stats_out = stats; }
+
+	// There are no nodes to replay, so show the solved board
+	if (result == SEARCH_SUCCESS
+	    && g_options.display_animate
+	    && !g_options.display_quiet) {
+		printf("\n");
+		game_print(info, final_state);
+	}
+
+	if (g_options.node_transpositions) {
+		ttable_destroy(&tt);
+	}
+	if (g_options.node_nogoods || g_options.node_split) {
+		nogood_destroy(&nogoods);
+	}
 
 	return result;
 
@@ -4,16 +4,72 @@
 
 #include "node.h"
 #include "engine.h"
+#include "transposition.h"
+#include "nogood.h"
+
+// Counters collected during a search, reported next to time and nodes
+typedef struct search_stats_struct {
+	size_t duplicates_pruned; // Children dropped by transposition table
+	size_t patterns_pruned;   // Children holding a dead domino pattern
+	size_t regions_isolated;  // Children with a region no color can fill
+	size_t regions_stranded;  // Children with a color cut off its goal
+	size_t cuts_checked;      // Children run through the cut-cell check
+	size_t cuts_pruned;       // Children it dropped
+	double cuts_seconds;      // Time spent in it
+	size_t forced_moves;      // Forced moves folded into children
+	size_t forced_dead;       // Children left with a stuck color
+	size_t domain_wipeouts;   // Children with a cell no color can take
+	size_t domain_stranded;   // Children with a color left no cells
+	size_t domain_picks;      // Next colors picked from owned cells
+	size_t nogood_pruned;     // Children holding a region shown to fail
+	size_t nogood_searches;   // Regions searched for a verdict
+	size_t nogood_hits;       // Region lookups that found a verdict
+	size_t nogood_misses;     // Region lookups that found nothing
+	size_t nogoods_evicted;   // Verdicts pushed out by newer ones
+	size_t splits;            // Children split into independent regions
+	size_t split_dead;        // Splits with a region that cannot be filled
+	size_t split_solved;      // Splits with every region filled
+	size_t split_searches;    // Regions searched for them
+	double split_seconds;     // Time spent on splits
+	int discrepancies;        // Limit the search ended at (-e lds)
+	size_t solution_choices;  // States on the solution path with a
+	                          // choice of moves
+	size_t solution_first;    // Those where it took the first (-O)
+	size_t enqueued;          // Frontier enqueue operations
+	size_t dequeued;          // Frontier dequeue operations
+	double queue_seconds;     // Time spent in them (with --queue-timing)
+	double startup_seconds;   // Time to set up storage and the root node
+	size_t committed_bytes;   // Node, frontier and -t table memory committed
+	size_t peak_rss_kb;       // Peak resident set size during the search
+	size_t reclaimed;         // Expanded nodes released as dead subtrees
+	size_t peak_live;         // Most nodes allocated at the same time
+	size_t stored;            // Nodes ever placed in the arena
+	size_t node_bytes;        // Bytes per node for this puzzle
+} search_stats_t;
 
 //////////////////////////////////////////////////////////////////////
 // Peforms Dijkstra  search
 
 int game_dijkstra_search(const game_info_t* info, const game_state_t* init_state, 
                         double* elapsed_out, size_t* nodes_out, 
-                        game_state_t* final_state);
+                        search_stats_t* stats_out, game_state_t* final_state);
+
+//////////////////////////////////////////////////////////////////////
+// Performs depth-first search on a single state, made and unmade in
+// place, or limited discrepancy search with -e lds; same arguments and
+// result as game_dijkstra_search
+
+int game_dfs_search(const game_info_t* info, const game_state_t* init_state,
+                    double* elapsed_out, size_t* nodes_out,
+                    search_stats_t* stats_out, game_state_t* final_state);
+
+//////////////////////////////////////////////////////////////////////
+// Print the counters of the enabled search features on one line,
+// preceded by lead; return the number of counters printed
+
+int search_stats_print(const search_stats_t* stats, const char* lead);
 
-// Adjust storage space for search nodes if deadends are found
-tree_node_t* deadend_mem_adjust(const game_info_t* info, tree_node_t* node, 
-                                node_memory_t* storage);
+// Check if state contains a deadend, so no node is stored for it
+int is_deadend(const game_info_t* info, const game_state_t* state);
 
 #endif
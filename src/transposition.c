@@ -0,0 +1,141 @@
+#include "transposition.h"
+
+//////////////////////////////////////////////////////////////////////
+// Allocate zeroed slots
+
+static uint64_t* ttable_alloc(size_t capacity) {
+
+	uint64_t* keys = calloc(capacity, sizeof(uint64_t));
+	if (!keys) {
+		fprintf(stderr, "out of memory creating transposition table!\n");
+		exit(1);
+	}
+	return keys;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Find the slot holding hash, or the empty slot where it belongs
+
+static size_t ttable_probe(const uint64_t* keys, size_t capacity,
+                           uint64_t hash) {
+
+	size_t mask = capacity - 1;
+	size_t i = (hash ^ (hash >> 32)) & mask;
+
+	while (keys[i] && keys[i] != hash) {
+		i = (i + 1) & mask;
+	}
+
+	return i;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Double the number of slots and rehash
+
+static void ttable_grow(ttable_t* t) {
+
+	size_t capacity = 2*t->capacity;
+	uint64_t* keys = ttable_alloc(capacity);
+
+	for (size_t i=0; i<t->capacity; ++i) {
+		if (t->keys[i]) {
+			keys[ttable_probe(keys, capacity, t->keys[i])] = t->keys[i];
+		}
+	}
+
+	free(t->keys);
+	t->keys = keys;
+	t->capacity = capacity;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Slots a table for max_entries hashes grows to: the load factor
+// stays at or below 1/2 so probe sequences stay short
+
+static size_t ttable_max_capacity(size_t max_entries) {
+
+	size_t capacity = 1024;
+	while (capacity < 2*max_entries) {
+		capacity *= 2;
+	}
+	return capacity;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Most bytes a table for max_entries hashes takes at once: its last
+// growth holds the old slots and the new ones
+
+size_t ttable_peak_bytes(size_t max_entries) {
+	return ttable_max_capacity(max_entries) / 2 * 3 * sizeof(uint64_t);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Create a table that grows on demand up to max_entries hashes
+
+ttable_t ttable_create(size_t max_entries) {
+
+	ttable_t t;
+
+	t.max_capacity = ttable_max_capacity(max_entries);
+
+	t.capacity = 1024;
+	t.keys = ttable_alloc(t.capacity);
+	t.count = 0;
+
+	return t;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Insert a hash; return 1 if it was new, 0 if already present. A
+// saturated table still finds the hashes it holds but keeps no more.
+
+int ttable_insert(ttable_t* t, uint64_t hash) {
+
+	// Zero marks empty slots
+	if (!hash) { hash = 1; }
+
+	// Never fill completely; once saturated, hashes already held are
+	// still found, but new ones are not kept
+	int full = 2*(t->count+1) > t->capacity;
+
+	if (full && t->capacity < t->max_capacity) {
+		ttable_grow(t);
+		full = 0;
+	}
+
+	size_t i = ttable_probe(t->keys, t->capacity, hash);
+
+	if (t->keys[i] == hash) {
+		return 0;
+	}
+
+	if (full) {
+		return 1;
+	}
+
+	t->keys[i] = hash;
+	++t->count;
+
+	return 1;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Forget every hash, keeping the slots allocated so far
+
+void ttable_clear(ttable_t* t) {
+	memset(t->keys, 0, t->capacity * sizeof(uint64_t));
+	t->count = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for table
+
+void ttable_destroy(ttable_t* t) {
+	free(t->keys);
+}
@@ -0,0 +1,44 @@
+#ifndef __TRANSPOSITION__
+#define __TRANSPOSITION__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Open-addressing set of Zobrist hashes for every state generated so
+// far (open and closed), used to drop duplicate states.
+typedef struct ttable_struct {
+	uint64_t* keys;     // Slots, 0 marks an empty slot
+	size_t capacity;    // Number of slots (power of 2)
+	size_t max_capacity;// Slots needed to hold max_entries keys
+	size_t count;       // Number of keys stored
+} ttable_t;
+
+//////////////////////////////////////////////////////////////////////
+// Most bytes a table for max_entries hashes takes at once
+
+size_t ttable_peak_bytes(size_t max_entries);
+
+//////////////////////////////////////////////////////////////////////
+// Create a table that grows on demand up to max_entries hashes
+
+ttable_t ttable_create(size_t max_entries);
+
+//////////////////////////////////////////////////////////////////////
+// Insert a hash; return 1 if it was new, 0 if already present. A
+// saturated table still finds the hashes it holds but keeps no more.
+
+int ttable_insert(ttable_t* t, uint64_t hash);
+
+//////////////////////////////////////////////////////////////////////
+// Forget every hash, keeping the slots allocated so far
+
+void ttable_clear(ttable_t* t);
+
+//////////////////////////////////////////////////////////////////////
+// Free memory allocated for table
+
+void ttable_destroy(ttable_t* t);
+
+#endif
@@ -287,13 +287,78 @@ double now() {
 	GetSystemTimeAsFileTime (&now.ft);
 	return (double)now.ns100 * 1e-7; // 100 nanoseconds = 0.1 microsecond
 #else
-	struct timeval tv;
-	gettimeofday(&tv, 0);
-	return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6;
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
 #endif
 
 }
 
+//////////////////////////////////////////////////////////////////////
+// Read a "Key: value kB" line from a /proc file, in KB (0 if absent)
+
+static size_t proc_read_kb(const char* filename, const char* key) {
+
+	FILE* fp = fopen(filename, "r");
+	if (!fp) { return 0; }
+
+	char line[256];
+	size_t value = 0;
+	size_t l = strlen(key);
+
+	while (fgets(line, sizeof(line), fp)) {
+		if (!strncmp(line, key, l) && line[l] == ':') {
+			value = strtoull(line + l + 1, NULL, 10);
+			break;
+		}
+	}
+
+	fclose(fp);
+	return value;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bytes of memory the system could give us without swapping (0 if
+// unknown)
+
+size_t available_memory() {
+
+	size_t kb = proc_read_kb("/proc/meminfo", "MemAvailable");
+	if (kb) { return kb * 1024; }
+
+#if !defined(_WIN32) && defined(_SC_AVPHYS_PAGES)
+	long pages = sysconf(_SC_AVPHYS_PAGES);
+	long page_size = sysconf(_SC_PAGESIZE);
+	if (pages > 0 && page_size > 0) {
+		return (size_t)pages * (size_t)page_size;
+	}
+#endif
+
+	return 0;
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Reset the peak resident set size of this process, if supported
+
+void peak_rss_reset() {
+
+	FILE* fp = fopen("/proc/self/clear_refs", "w");
+	if (fp) {
+		fputs("5", fp);
+		fclose(fp);
+	}
+
+}
+
+//////////////////////////////////////////////////////////////////////
+// Peak resident set size in KB since the last reset (0 if unknown)
+
+size_t peak_rss_kb() {
+	return proc_read_kb("/proc/self/status", "VmHWM");
+}
+
 //////////////////////////////////////////////////////////////////////
 // Create a delay
 
@@ -13,6 +13,10 @@
 
 #include "engine.h"
 
+// Body of a kernel that is instantiated with constant arguments (board
+// size, pruning options) so the compiler can specialize each copy
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+
 ////////////////////////////////////////////////////////
 // Search termination results
 enum {
@@ -151,6 +155,22 @@ int cmp(int a, int b);
 
 double now();
 
+//////////////////////////////////////////////////////////////////////
+// Bytes of memory the system could give us without swapping (0 if
+// unknown)
+
+size_t available_memory();
+
+//////////////////////////////////////////////////////////////////////
+// Reset the peak resident set size of this process, if supported
+
+void peak_rss_reset();
+
+//////////////////////////////////////////////////////////////////////
+// Peak resident set size in KB since the last reset (0 if unknown)
+
+size_t peak_rss_kb();
+
 //////////////////////////////////////////////////////////////////////
 // Create a delay
 
@@ -166,4 +186,21 @@ pos_t pos_from_coords(pos_t x, pos_t y);
 
 void pos_get_coords(pos_t p, int* x, int* y);
 
+//////////////////////////////////////////////////////////////////////
+// Are two 8-bit positions next to each other? Rows are 16 apart, so
+// only a neighbor differs by 1 or 16.
+
+static inline int pos_adjacent(pos_t a, pos_t b) {
+	int delta = (int)a - (int)b;
+	return delta == 1 || delta == -1 || delta == 16 || delta == -16;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Bitflags of the colors not completed yet
+
+static inline int live_colors(const game_info_t* info,
+                              const game_state_t* state) {
+	return ~state->completed & ((1 << info->num_colors) - 1);
+}
+
 #endif